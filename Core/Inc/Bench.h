@@ -0,0 +1,41 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Boot-time benchmark of the per-packet receive path, to compare clock
+ * profiles (Clock.h) and RAM-resident code: one MotorAngle frame pushed
+ * byte by byte through a FrameParser, decoded (CRC check) and answered
+ * with an encoded CarConfirmation (CRC again), as the link does, but
+ * without dispatching it to the motors.
+ *
+ * Cycles come from the DWT counter, wall time from cycles / SystemCoreClock.
+ * The result is one BENCH_PACKET log record; build once per profile and
+ * compare the records.
+ */
+
+// 1: run Bench_Packet at boot
+#ifndef BENCH_ENABLE
+#define BENCH_ENABLE 0
+#endif
+
+#define BENCH_PACKET_COUNT 1000U
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Time BENCH_PACKET_COUNT packets and log min / average cycles and
+ *        the average wall time. Needs Log_Init and CycleCounter_Init first.
+ */
+void Bench_Packet(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BENCH_H
@@ -0,0 +1,55 @@
+#ifndef CALIB_STORE_H
+#define CALIB_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Calibration records kept in a flash sector reserved by the linker script
+ * (STM32F401XX_FLASH.ld stops FLASH before it). Records are appended one
+ * after the other, the sector is only erased once it is full, so a save
+ * costs a few word writes instead of a sector erase.
+ *
+ * Record: [magic 16 | version 8 | data words 8] [data ...] [crc16 of the
+ * header and data]. The last record with a good CRC wins.
+ */
+
+/* ================== Storage Sector ================== */
+// A 16 KB sector right after the vector table: fast to erase, costs the
+// application region 32 KB (sectors 0 and 1) instead of the 128 KB sector 5
+#define CALIB_STORE_SECTOR FLASH_SECTOR_1
+#define CALIB_STORE_ADDR   0x08004000U
+#define CALIB_STORE_SIZE   0x4000U        // 16 KB
+
+#define CALIB_STORE_MAGIC    0xCA1BU
+#define CALIB_STORE_MAX_SIZE 32U // data bytes per record
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Copy the latest valid record into data.
+ *
+ * @param version : layout version of data, records of another version are ignored
+ * @param size    : bytes, a multiple of 4, at most CALIB_STORE_MAX_SIZE
+ * @return 1 if a record of this version and size was found, 0 otherwise
+ */
+uint8_t CalibStore_Load(uint8_t version, void *data, uint16_t size);
+
+/**
+ * @brief Append a record, erasing the sector first when it is full.
+ *        Blocks while flash is programmed (CPU stalls on flash reads,
+ *        up to ~0.5 s when the sector has to be erased): call it from the
+ *        main loop with the motors stopped.
+ *
+ * @return 1 if the record was written and reads back with a good CRC
+ */
+uint8_t CalibStore_Save(uint8_t version, const void *data, uint16_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALIB_STORE_H
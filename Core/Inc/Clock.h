@@ -0,0 +1,62 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * System clock profiles, selected at build time with CLOCK_PROFILE and
+ * applied by SystemClock_Config.
+ *
+ *   CLOCK_PROFILE_HSI16  16 MHz HSI, no PLL, 0 flash wait states. Lowest
+ *                        run current; the CubeMX configuration.
+ *   CLOCK_PROFILE_PLL84  HSI through the PLL to 84 MHz (the F401 limit in
+ *                        voltage scale 2), APB1 42 MHz, 2 flash wait states.
+ *
+ * In both profiles every timer runs from SYSCLK (APB1 timers get twice the
+ * divided PCLK1), so CLOCK_TIMER_HZ sizes the fixed prescalers. The UART
+ * baud rates and the PWM prescaler are computed at init from the live bus
+ * clocks. Prefetch, I-cache and D-cache (the ART accelerator) are enabled
+ * by HAL_Init through stm32f4xx_hal_conf.h.
+ *
+ * HOT_FUNC places code that runs on every tick or received frame in SRAM
+ * (.RamFunc, copied with .data by the startup code, see
+ * STM32F401XX_FLASH.ld). It only pays off with flash wait states, so it
+ * is on by default in the PLL profile only. This header needs no HAL, the
+ * portable modules (FrameParser, CheckSum) use it too.
+ */
+
+#define CLOCK_PROFILE_HSI16 0
+#define CLOCK_PROFILE_PLL84 1
+
+#ifndef CLOCK_PROFILE
+#define CLOCK_PROFILE CLOCK_PROFILE_HSI16
+#endif
+
+#if CLOCK_PROFILE == CLOCK_PROFILE_PLL84
+#define CLOCK_SYSCLK_HZ    84000000U
+#define CLOCK_FLASH_LATENCY FLASH_LATENCY_2
+#else
+#define CLOCK_SYSCLK_HZ    16000000U
+#define CLOCK_FLASH_LATENCY FLASH_LATENCY_0
+#endif
+
+#define CLOCK_TIMER_HZ CLOCK_SYSCLK_HZ // TIM2-5 and TIM9-11 input clock
+
+// 1: run the HOT_FUNC functions from SRAM
+#ifndef CLOCK_RAM_FUNCS
+#define CLOCK_RAM_FUNCS (CLOCK_PROFILE == CLOCK_PROFILE_PLL84)
+#endif
+
+#if CLOCK_RAM_FUNCS
+#define HOT_FUNC __attribute__((section(".RamFunc"))) // the HAL's __RAM_FUNC section
+#else
+#define HOT_FUNC
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CLOCK_H
@@ -0,0 +1,44 @@
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+/*
+ * DWT cycle counter, counts core clock cycles (SystemCoreClock Hz).
+ * Used to time code sections on target, wraps every 2^32 cycles.
+ * It stops while the core sleeps in Power_Idle (unless a debugger sets
+ * DBGMCU DBG_SLEEP), so it measures run time only: anything spanning an
+ * idle period (timeouts, wall-clock intervals) counts control ticks or
+ * reads HAL_GetTick instead.
+ */
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Enable and reset the DWT cycle counter. Call once at start up.
+ */
+static inline void CycleCounter_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Current cycle count, subtract two readings for an elapsed time.
+ */
+static inline uint32_t CycleCounter_Now(void)
+{
+    return DWT->CYCCNT;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CYCLE_COUNTER_H
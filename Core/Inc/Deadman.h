@@ -0,0 +1,71 @@
+#ifndef DEADMAN_H
+#define DEADMAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Command link supervisor. Every intact frame from the host (commands,
+ * duplicates and Heartbeat packets alike) feeds it from the main loop.
+ * The check runs in the 1 kHz control tick, so a stalled link and a
+ * blocked main loop both trip it: the wheels ramp to zero and the
+ * steering holds where it is. The next frame re-arms it; motors stay
+ * stopped until commanded again.
+ *
+ * Time is counted in Deadman_Tick calls (1 ms each), not with the DWT
+ * cycle counter: CYCCNT stops while Power_Idle sleeps. The deadline is
+ * therefore resolved to one tick; the reported latency is how late the
+ * tick that tripped ran after its TIM10 update.
+ */
+
+#define DEADMAN_TIMEOUT_MS 500U // default silence before tripping
+#define DEADMAN_RAMP_MS    200U // drive PWM ramp from full scale to zero
+
+typedef struct
+{
+    uint32_t trips;
+    uint32_t lastLatencyUs; // delay of the tripping tick after its TIM10 update
+    uint32_t maxLatencyUs;
+    uint32_t lastStopMs;    // timeout expiry to both wheels at zero PWM
+} DeadmanStats;
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Disarmed until the first Deadman_Feed, timeout DEADMAN_TIMEOUT_MS.
+ */
+void Deadman_Init(void);
+
+/**
+ * @brief Service the supervisor (re-arms it after a trip).
+ */
+void Deadman_Feed(void);
+
+/**
+ * @brief Change the silence allowed before tripping, 0 disables the supervisor.
+ */
+void Deadman_SetTimeout(uint16_t timeout_ms);
+
+/**
+ * @brief 1 from a trip until the next Deadman_Feed.
+ */
+uint8_t Deadman_IsTripped(void);
+
+/**
+ * @brief Check for silence and report the stop. Called from the 1 kHz control tick.
+ */
+void Deadman_Tick(void);
+
+/**
+ * @brief Snapshot of the trip count and the measured trip latency.
+ */
+void Deadman_GetStats(DeadmanStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEADMAN_H
@@ -0,0 +1,91 @@
+#ifndef ENCODER_H
+#define ENCODER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Quadrature encoders on TIM2 / TIM5 (wheels, 32-bit counters) and TIM3
+ * (steering, 16-bit counter), all in TI12 mode: every edge of both
+ * channels counts (x4 decoding).
+ *
+ * The hardware counters are extended to 64 bits by wrap-aware differencing:
+ * Encoder_Update adds the signed difference since its last read, taken at
+ * the counter's own width, so a counter rolling over is just another step.
+ * This holds as long as a counter moves less than half its range between
+ * two updates (32767 counts per ms on TIM3).
+ *
+ * Velocity uses the mixed M/T method at a fixed ENCODER_VELOCITY_HZ: the
+ * counts between the last timestamped edge before the previous sample and
+ * the last one before this sample, divided by the time between those two
+ * edges. Fast, it is a plain count over the sample period; slow, it times
+ * the period between edges instead of reading 0 or 1 count.
+ *
+ * Edges are timestamped to 1 us: channel A of each encoder (PA15, PA0,
+ * PA6) also drives its EXTI line, the pin stays in timer AF mode. The
+ * interrupt reads TIM10 (1 us per count) and the encoder counter, then
+ * masks its line until the next Encoder_Update re-arms it, so there is at
+ * most one edge interrupt per encoder and ms at any speed. The timestamp
+ * is taken relative to the arming update, which assumes Encoder_Update
+ * runs once per TIM10 period (both builds release it from that interrupt).
+ */
+
+typedef enum
+{
+    ENCODER_WHEEL1 = 0, // TIM2, motor 1
+    ENCODER_WHEEL2,     // TIM5, motor 2
+    ENCODER_STEER,      // TIM3, steering
+    ENCODER_COUNT
+} EncoderId;
+
+#define ENCODER_EDGES_PER_LINE 4 // TI12 counts both edges of A and B
+
+/* ================== Velocity ================== */
+#define ENCODER_UPDATE_HZ           1000U // Encoder_Update rate (control tick)
+#define ENCODER_VELOCITY_DIVIDER    5U    // updates per velocity sample
+#define ENCODER_VELOCITY_HZ         (ENCODER_UPDATE_HZ / ENCODER_VELOCITY_DIVIDER)
+#define ENCODER_VELOCITY_TIMEOUT_MS 250U  // no edge for this long reads as stopped
+
+// 1: smooth the estimate with a 2nd-order Butterworth low-pass (arm_biquad_cascade_df1_f32)
+#ifndef ENCODER_VELOCITY_FILTER
+#define ENCODER_VELOCITY_FILTER 1
+#endif
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Start the three encoder timers with every position at 0.
+ */
+void Encoder_Init(void);
+
+/**
+ * @brief Fold the counter movement into the 64-bit positions.
+ *        Called from the 1 kHz control tick, before the control loops.
+ */
+void Encoder_Update(void);
+
+/**
+ * @brief Timestamp an encoder A edge. Called from HAL_GPIO_EXTI_Callback.
+ */
+void Encoder_OnEdge(uint16_t pin);
+
+/**
+ * @brief Position in counts (4 per encoder line), includes movement since
+ *        the last Encoder_Update. Safe from the main loop and interrupts.
+ */
+int64_t Encoder_GetPosition(EncoderId id);
+
+/**
+ * @brief Latest velocity sample in counts/s (filtered when
+ *        ENCODER_VELOCITY_FILTER is set), refreshed at ENCODER_VELOCITY_HZ.
+ */
+float Encoder_GetVelocity(EncoderId id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENCODER_H
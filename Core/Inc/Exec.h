@@ -0,0 +1,95 @@
+#ifndef EXEC_H
+#define EXEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Cooperative multi-rate executive driven by the TIM10 update interrupt.
+ *
+ * Tasks are listed in one table, highest priority first (rate monotonic:
+ * shortest period first). Each one runs every periodTicks ticks either
+ * - EXEC_IN_TICK: inside the tick interrupt, in table order, for the
+ *   control loops that must never wait for the main loop, or
+ * - EXEC_IN_LOOP: in the main loop. Exec_RunLoop runs the highest priority
+ *   task that has been released; tasks run to completion, so a loop task
+ *   waits at most one tick plus the longest lower priority loop task.
+ *
+ * Every task has a deadline equal to its period. A loop task still
+ * pending at its next release, or finishing after its deadline, counts a
+ * miss; so does a tick task finishing later than its period after the
+ * tick started. Execution time is measured with the DWT cycle counter
+ * (CycleCounter_Init must run first).
+ */
+
+#define EXEC_TICK_HZ   1000U // TIM10 update rate
+#define EXEC_MAX_TASKS 12U
+
+typedef enum
+{
+    EXEC_IN_TICK = 0,
+    EXEC_IN_LOOP,
+} ExecContext;
+
+typedef struct
+{
+    void (*run)(void);
+    uint16_t periodTicks;
+    ExecContext context;
+} ExecTask;
+
+typedef struct
+{
+    uint32_t runs;
+    uint32_t misses;
+    uint32_t lastCycles;
+    uint32_t maxCycles;
+} ExecTaskStats;
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Take the task table (kept by reference, at most EXEC_MAX_TASKS).
+ *        Every task is released on the first tick.
+ */
+void Exec_Init(const ExecTask *tasks, uint8_t count);
+
+/**
+ * @brief Release due tasks and run the EXEC_IN_TICK ones.
+ *        Called from HAL_TIM_PeriodElapsedCallback (TIM10).
+ */
+void Exec_Tick(void);
+
+/**
+ * @brief Run the highest priority released EXEC_IN_LOOP task, if any.
+ * @return 1 if a task ran, 0 if nothing was ready
+ */
+uint8_t Exec_RunLoop(void);
+
+/**
+ * @brief Drop every pending release and release all tasks again on the
+ *        next tick, without counting misses; the stats are kept. For a
+ *        pause of the tick (Stop mode): stop TIM10 first, call this before
+ *        restarting it, so the pause is neither run time nor a miss.
+ */
+void Exec_Restart(void);
+
+/**
+ * @brief 1 if a loop task has been released and not run yet. Call it with
+ *        interrupts masked to decide on sleeping (see Power_Idle).
+ */
+uint8_t Exec_HasPending(void);
+
+/**
+ * @brief Snapshot of one task's counters, index as in the table.
+ */
+void Exec_GetStats(uint8_t task, ExecTaskStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EXEC_H
@@ -0,0 +1,76 @@
+#ifndef FRAME_PARSER_H
+#define FRAME_PARSER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* ================== Configuration ================== */
+#define FRAME_PARSER_MAX_LEN 32 // longest frame the parser can buffer
+
+typedef struct
+{
+    uint16_t startMarker; // first two bytes, little endian on the wire
+    uint16_t endMarker;   // last two bytes, little endian on the wire
+    uint8_t headerLen;    // bytes (markers included) needed by lengthOf
+
+    /**
+     * @brief Total frame length from the buffered header.
+     * @return length in bytes, 0 if the header is invalid
+     */
+    uint16_t (*lengthOf)(const uint8_t *header);
+
+    /**
+     * @brief Called with every frame whose markers and length check out.
+     */
+    void (*onFrame)(const uint8_t *frame, uint16_t len);
+} FrameParserConfig;
+
+typedef struct
+{
+    uint32_t bytes;          // bytes fed to the parser
+    uint32_t frames;         // frames delivered to onFrame
+    uint32_t errors;         // start, length or end marker failures
+    uint32_t discarded;      // bytes dropped while resynchronizing
+    uint32_t resyncBytes;    // bytes from the last error to the next good frame
+    uint32_t maxResyncBytes; // worst resyncBytes seen
+} FrameParserStats;
+
+typedef struct
+{
+    const FrameParserConfig *config;
+    uint8_t buf[FRAME_PARSER_MAX_LEN];
+    uint16_t count;     // bytes buffered
+    uint16_t valid;     // leading bytes of buf already validated
+    uint16_t expected;  // frame length once the header is in, 0 before
+    uint8_t resyncing;  // an error was seen and no good frame since
+    uint32_t sinceError;
+    FrameParserStats stats;
+} FrameParser;
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Reset the parser and its statistics.
+ */
+void FrameParser_Init(FrameParser *parser, const FrameParserConfig *config);
+
+/**
+ * @brief Feed one received byte.
+ *        On a marker or length failure the bytes already buffered are
+ *        rescanned for the next start marker instead of being thrown away.
+ */
+void FrameParser_PushByte(FrameParser *parser, uint8_t byte);
+
+/**
+ * @brief Feed a block of received bytes.
+ */
+void FrameParser_Push(FrameParser *parser, const uint8_t *data, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_PARSER_H
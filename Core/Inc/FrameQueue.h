@@ -0,0 +1,62 @@
+#ifndef FRAME_QUEUE_H
+#define FRAME_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "PacketCodec.h"
+
+/* ================== Configuration ================== */
+#define FRAME_QUEUE_DEPTH      8                      // frames, power of two
+#define FRAME_QUEUE_SLOT_SIZE  PACKET_MAX_FRAME_SIZE  // bytes per frame
+
+typedef struct
+{
+    uint32_t depth;      // frames currently queued
+    uint32_t highWater;  // max depth seen since init
+    uint32_t overflows;  // frames dropped because the queue was full
+    uint32_t pushed;     // frames accepted since init
+} FrameQueueStats;
+
+/* ================== Public API ================== */
+/*
+ * Single producer (UART receive ISR) / single consumer (main loop).
+ * Lock-free: the producer only writes head, the consumer only writes tail.
+ */
+
+/**
+ * @brief Empty the queue and clear the counters. Call before reception starts.
+ */
+void FrameQueue_Init(void);
+
+/**
+ * @brief Copy a complete frame into the queue (producer side).
+ * @return 1 if queued, 0 if the queue was full or the frame too long
+ */
+uint8_t FrameQueue_Push(const uint8_t *frame, uint8_t len);
+
+/**
+ * @brief Oldest queued frame, left in place until FrameQueue_Release() (consumer side).
+ *
+ * @param len : set to the frame length
+ * @return pointer to the frame bytes, NULL if the queue is empty
+ */
+const uint8_t *FrameQueue_Peek(uint8_t *len);
+
+/**
+ * @brief Free the slot returned by the last FrameQueue_Peek().
+ */
+void FrameQueue_Release(void);
+
+/**
+ * @brief Snapshot of queue depth and overflow counters.
+ */
+void FrameQueue_GetStats(FrameQueueStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_QUEUE_H
@@ -1,11 +1,67 @@
+#ifndef HORN_H
+#define HORN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #include <stdint.h>
 #include "stm32f4xx_hal.h"
 
-// Light on PB1
+/*
+ * Horn relay and a non-blocking pattern sequencer.
+ *
+ * A pattern is a list of on/off durations in ms, starting with "on".
+ * Horn_Play returns at once; the steps are timed by a soft timer
+ * (SOFT_TIMER_HORN) in the 1 kHz control tick. A pattern is repeated,
+ * separated by its repeat gap, until the requested duration has passed
+ * (the last repetition is played to its end). Starting a pattern, or
+ * Horn_On / Horn_Off, cancels the one playing.
+ */
+
+// Horn relay on PB0
 #define HORN_GPIO_PORT GPIOB
 #define HORN_PIN    GPIO_PIN_0
 
+// CarHorn pattern field
+typedef enum
+{
+    HORN_PATTERN_CONTINUOUS = 0, // on for the whole duration, duration 0 silences the horn
+    HORN_PATTERN_SINGLE,         // one 300 ms honk
+    HORN_PATTERN_DOUBLE,         // two 100 ms chirps
+    HORN_PATTERN_SOS,            // ... --- ...
+    HORN_PATTERN_COUNT
+} HornPattern;
+
+/* ================== Public API ================== */
+
 void Horn_Init(void);
+
+/**
+ * @brief Relay on until Horn_Off or the next pattern.
+ */
 void Horn_On(void);
+
+/**
+ * @brief Relay off, stops any pattern.
+ */
 void Horn_Off(void);
-void Horn_Toggle(uint32_t delay);
\ No newline at end of file
+
+/**
+ * @brief Start a pattern, replacing the one playing. Returns at once.
+ *
+ * @param duration_ms : keep repeating for this long, 0 plays it once
+ *                      (silences the horn for HORN_PATTERN_CONTINUOUS)
+ */
+void Horn_Play(HornPattern pattern, uint32_t duration_ms);
+
+/**
+ * @brief 1 while a pattern is playing.
+ */
+uint8_t Horn_IsPlaying(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HORN_H
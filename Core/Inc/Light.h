@@ -16,5 +16,5 @@ void Light_Back_On(void);
 void Light_Back_Off(void);
 void Light_Right_On(void);
 void Light_Right_Off(void);
-void Light_Left_Off(void);
+void Light_Left_On(void);
 void Light_Left_Off(void);
\ No newline at end of file
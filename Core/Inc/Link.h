@@ -0,0 +1,115 @@
+#ifndef LINK_H
+#define LINK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "PacketCodec.h"
+
+/*
+ * Sequence tracking and responses for the command link.
+ *
+ * Every received frame is answered with one binary CarConfirmation frame,
+ * same framing and CRC as the requests:
+ *   ID                 LINK_CAR_ID
+ *   packetID           packet type being confirmed
+ *   confirmationStatus CONFIRM_ACK, a NACK reason, or one of the link codes below
+ *   value              seq of the frame being confirmed
+ *   [echo]             with LINK_ECHO_PAYLOAD, the executed payload (ACK only)
+ *
+ * NACK reasons are the SerializePacket / PacketCodec_Decode result codes:
+ *   2 CRC mismatch, 3 unknown packet ID, 4 bad angle, 5 bad motor ID,
+ *   6 bad speed, 7 bad direction, 8 bad light status, 9 bad payload length,
+ *   10 bad batch count, 11 bad horn pattern, 12 bad PWM mode
+ *
+ * The host may keep up to LINK_WINDOW frames in flight and retransmits only
+ * the seqs that are NACKed or time out. Two things are tracked per seq:
+ * - received: the frame arrived intact. Seqs skipped over when a newer one
+ *   arrives never did, they are NACKed once as CONFIRM_MISSING with packetID
+ *   PACKET_ID_NONE (at most LINK_MAX_GAP_NACKS per gap, the host times out
+ *   the rest). A frame that arrived but was rejected is only NACKed with
+ *   its reason, never reported missing.
+ * - executed: the frame ran. A retransmission of it is confirmed as
+ *   CONFIRM_DUPLICATE and not run again; a rejected one is checked again.
+ * A jump of LINK_WINDOW seqs or more either way restarts the window.
+ */
+
+#define LINK_CAR_ID  0x01
+#define LINK_WINDOW  32 // seqs remembered for duplicate detection
+
+// Echo the executed payload in ACKs
+#ifndef LINK_ECHO_PAYLOAD
+#define LINK_ECHO_PAYLOAD 0
+#endif
+
+// Debug: also send the old text replies ("Packet OK" + hex dump) on the command link
+#ifndef LINK_ASCII_REPLIES
+#define LINK_ASCII_REPLIES 0
+#endif
+
+// confirmationStatus values; 0x01..0x7F are NACKs carrying the result code
+#define CONFIRM_ACK        0x00 // executed
+#define CONFIRM_DUPLICATE  0x80 // already executed, ignored
+#define CONFIRM_MISSING    0x81 // seq never arrived, retransmit it
+
+typedef enum
+{
+    LINK_NEW = 0,    // not executed yet, run it
+    LINK_DUPLICATE   // already executed
+} LinkVerdict;
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Forget all seqs, the next frame restarts the window.
+ */
+void Link_Init(void);
+
+/**
+ * @brief Note an intact frame. Seqs skipped over since the highest one
+ *        received are NACKed with CONFIRM_MISSING so the host can retransmit
+ *        them. Call it before Link_Respond, so the NACKs go out first.
+ *
+ * @param seq : seq of a frame that passed the CRC check
+ */
+void Link_Receive(uint8_t seq);
+
+/**
+ * @brief Whether the frame with this seq was executed already. Changes nothing.
+ *
+ * @param seq : seq passed to Link_Receive
+ */
+LinkVerdict Link_Check(uint8_t seq);
+
+/**
+ * @brief Record seq as executed, its retransmissions become duplicates.
+ *
+ * @param seq : seq passed to Link_Receive, of a frame that decoded and ran
+ */
+void Link_Record(uint8_t seq);
+
+/**
+ * @brief Answer a received frame.
+ *
+ * @param packet : decoded frame, seq/packetID best effort for a rejected one
+ *                 (see PacketCodec_Decode); NULL sends no binary response
+ * @param status : CONFIRM_ACK, a NACK result code or CONFIRM_DUPLICATE
+ */
+void Link_Respond(const PacketView *packet, uint8_t status);
+
+/**
+ * @brief Send a CarConfirmation frame on the command link.
+ *
+ * @param echo    : payload bytes appended after the confirmation, may be NULL
+ * @param echoLen : bytes of echo, cut to what fits in one frame
+ */
+void Link_SendConfirmation(uint8_t seq, uint8_t packetID, uint8_t status,
+                           const uint8_t *echo, uint8_t echoLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINK_H
@@ -0,0 +1,92 @@
+#ifndef LOG_H
+#define LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+/*
+ * Deferred binary logger on the debug UART (USART1).
+ *
+ * LOG() only copies a site ID, the tick and the raw arguments into a RAM
+ * ring; formatting happens on the host (tools/log_decode.py). The ring is
+ * drained by DMA in the background, a full ring drops new records.
+ *
+ * Record on the wire:
+ *   LOG_SYNC | site ID | HAL tick (uint32 LE) | argument count x int32 LE
+ */
+
+/* ================== Configuration ================== */
+#define LOG_RING_SIZE  1024  // bytes, power of two
+#define LOG_MAX_ARGS   5
+#define LOG_SYNC       0xA5
+
+typedef enum
+{
+#define LOG_SITE(name, nargs, fmt) LOG_##name,
+#include "LogSites.h"
+#undef LOG_SITE
+    LOG_SITE_COUNT
+} LogSiteId;
+
+typedef struct
+{
+    uint32_t written;    // records accepted since init
+    uint32_t dropped;    // records lost because the ring was full
+    uint32_t highWater;  // max ring bytes in use since init
+} LogStats;
+
+/**
+ * @brief Record a log site with up to LOG_MAX_ARGS integer arguments.
+ *        Safe from interrupts, never waits for the UART.
+ *
+ * Example: LOG(MOTOR_SPEED, 1, encoder, speed, direction);
+ */
+#define LOG(name, ...) \
+    Log_Write(LOG_##name, (const int32_t[LOG_MAX_ARGS]){__VA_ARGS__})
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Start draining the ring on the debug UART. Records written
+ *        before this call are kept and sent once it runs.
+ * @param huart : debug handle (USART1), TX DMA linked
+ */
+void Log_Init(UART_HandleTypeDef *huart);
+
+/**
+ * @brief Append one record, use the LOG() macro instead.
+ */
+void Log_Write(LogSiteId id, const int32_t *args);
+
+/**
+ * @brief Start a DMA transfer of pending records if none is running.
+ *        Called from SysTick, so the ring drains without the main loop.
+ */
+void Log_Flush(void);
+
+/**
+ * @brief Release the sent bytes and chain the next transfer.
+ *        Called from HAL_UART_TxCpltCallback.
+ */
+void Log_OnTxCplt(void);
+
+/**
+ * @brief Drop the chunk of an aborted transfer.
+ *        Called from HAL_UART_ErrorCallback.
+ */
+void Log_OnError(void);
+
+/**
+ * @brief Snapshot of the logger counters.
+ */
+void Log_GetStats(LogStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LOG_H
@@ -0,0 +1,64 @@
+/*
+ * Log sites, one line each: LOG_SITE(name, argument count, format).
+ * Included by Log.h / Log.c to build the site IDs and argument counts,
+ * and parsed by tools/log_decode.py to print the records. Arguments are
+ * int32, the format may only use integer conversions (%d, %u, %X, ...).
+ * Append new sites at the end so existing IDs keep their meaning.
+ *
+ * No include guard, this file is meant to be included several times.
+ */
+
+LOG_SITE(BOOT,               0, "STM32 Ready for Packets...")
+LOG_SITE(CHECKSUM,           1, "CRC: %04X") // no longer logged, kept so later IDs stay put
+
+LOG_SITE(PACKET_UNKNOWN_ID,  1, "Unknown packet ID %02X")
+LOG_SITE(PACKET_BAD_LENGTH,  2, "Invalid payload length: ID %02X len %d")
+LOG_SITE(PACKET_BAD_FIELD,   3, "Invalid field: ID %02X error %d value %d")
+LOG_SITE(PACKET_MOTOR_ANGLE, 3, "Motor angle packet: M%02X angle=%d direction=%d")
+
+LOG_SITE(MOTOR_SPEED,        4, "Motor %d Enc=%d, PWM=%d%%, Dir=%d")
+
+LOG_SITE(ANGLE_CMD,          3, "Angle sent=%d Target=%d Current=%d")
+LOG_SITE(ANGLE_TRACK,        5, "Target=%d Current=%d max=%d min=%d error=%d")
+LOG_SITE(ANGLE_REACHED,      2, "Target reached: Target=%d Current=%d")
+LOG_SITE(ANGLE_OUT_OF_RANGE, 4, "Target out of range: Target=%d Current=%d max=%d min=%d")
+LOG_SITE(CALIB_ARR,          1, "arr %d")
+LOG_SITE(CALIB_RAW,          1, "raw=%d")
+LOG_SITE(CALIB_DONE,         3, "min=%d mid=%d max=%d")
+
+LOG_SITE(HORN_INIT,          0, "horn init")
+LOG_SITE(HORN_ON,            0, "horn on")
+LOG_SITE(HORN_OFF,           0, "horn off")
+LOG_SITE(HORN_TOGGLE,        1, "Horn toggle %d ms") // no longer logged, kept so later IDs stay put
+
+LOG_SITE(LIGHT_INIT,         0, "light init")
+LOG_SITE(LIGHT_FRONT_ON,     0, "Light_Front_On")
+LOG_SITE(LIGHT_FRONT_OFF,    0, "Light_Front_Off")
+LOG_SITE(LIGHT_BACK_ON,      0, "Light_Back_On")
+LOG_SITE(LIGHT_BACK_OFF,     0, "Light_Back_Off")
+LOG_SITE(LIGHT_RIGHT_ON,     0, "Light_Right_On")
+LOG_SITE(LIGHT_RIGHT_OFF,    0, "Light_Right_Off")
+LOG_SITE(LIGHT_LEFT_ON,      0, "Light_Left_On")
+LOG_SITE(LIGHT_LEFT_OFF,     0, "Light_Left_Off")
+
+LOG_SITE(CALIB_LOADED,       3, "Stored calibration: min=%d mid=%d max=%d")
+LOG_SITE(CALIB_SAVED,        1, "Calibration saved: ok=%d")
+LOG_SITE(CALIB_FAILED,       2, "Calibration failed: state=%d raw=%d")
+
+LOG_SITE(DEADMAN_TRIP,       2, "Deadman: no frame for %u ms, detected %u us late")
+LOG_SITE(DEADMAN_STOPPED,    1, "Deadman: wheels stopped %u ms after the timeout")
+
+LOG_SITE(PWM_CONFIG,         3, "PWM %u Hz: PSC=%u period=%u")
+
+LOG_SITE(TELEMETRY,          5, "steer=%d atTarget=%d rpm1=%d rpm2=%d deadman=%d")
+LOG_SITE(EXEC_MISS,          3, "Task %d missed its deadline (%u misses, max %u cycles)")
+LOG_SITE(RTOS_START_FAILED,  0, "RTOS: could not create the threads and queues")
+
+LOG_SITE(CPU_LOAD,           2, "CPU load %d permille (%u us idle in the last second)")
+LOG_SITE(POWER_PARK,         1, "No frame for %u s, parking in Stop mode")
+LOG_SITE(POWER_WAKE,         0, "Woken by the command link, re-homing the steering")
+
+LOG_SITE(BENCH_PACKET,       5, "Bench %u MHz: packet min %u / avg %u cycles, avg %u ns, %u failed")
+
+LOG_SITE(HORN_PATTERN,       2, "Horn pattern %d for %u ms")
+LOG_SITE(STEER_STALL_REHOME, 2, "Steering stalled at %d (target %d), re-homing")
@@ -0,0 +1,67 @@
+#ifndef MOTION_PROFILE_H
+#define MOTION_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Online setpoint generator: moves a setpoint towards a target with limited
+ * velocity and acceleration (trapezoidal), and optionally limited jerk
+ * (S-curve). The target and the limits may change at any time, the
+ * trajectory continues smoothly from the current state.
+ * Units are the caller's (e.g. encoder counts and seconds).
+ */
+
+typedef struct
+{
+    float maxVelocity;  // > 0
+    float maxAccel;     // > 0
+    float maxJerk;      // 0 = no jerk limit (trapezoidal)
+} MotionLimits;
+
+typedef struct
+{
+    MotionLimits limits;
+    float target;
+    float position;     // current setpoint
+    float velocity;
+    float accel;
+    uint8_t done;       // setpoint has reached the target and stopped
+} MotionProfile;
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Start at rest at position.
+ */
+void MotionProfile_Init(MotionProfile *profile, const MotionLimits *limits, float position);
+
+/**
+ * @brief Jump to position and stop, e.g. after the actuator was moved externally.
+ */
+void MotionProfile_Reset(MotionProfile *profile, float position);
+
+/**
+ * @brief New target, reached from the current position/velocity within the limits.
+ */
+void MotionProfile_SetTarget(MotionProfile *profile, float target);
+
+/**
+ * @brief Change the limits, applied from the next step on.
+ */
+void MotionProfile_SetLimits(MotionProfile *profile, const MotionLimits *limits);
+
+/**
+ * @brief Advance the trajectory by dt seconds.
+ * @return the new setpoint
+ */
+float MotionProfile_Step(MotionProfile *profile, float dt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOTION_PROFILE_H
@@ -2,23 +2,85 @@
 #define MOTOR_ANGLE_H
 
 #include "stm32f4xx_hal.h"
+#include "MotionProfile.h"
 
 /* ================== Motor Direction ================== */
 #define MOTOR_DIR_CW   1   // Clockwise
 #define MOTOR_DIR_CCW  0   // Counter-Clockwise
 
+/* ================== Position Control ================== */
+#define STEER_CONTROL_HZ       1000U  // Motor_Angle_ControlTick rate (TIM10)
+#define STEER_KP               0.01f  // duty per count of error (x4 counts)
+#define STEER_KI               0.0001f // per tick
+#define STEER_KD               0.025f // per tick
+#define STEER_MAX_DUTY         0.6f
+#define STEER_DEADBAND_COUNTS  4      // hold without driving when this close
+
+// Default setpoint trajectory limits, see Motor_Angle_SetProfileLimits
+#define STEER_PROFILE_MAX_VELOCITY 1200.0f // counts/s
+#define STEER_PROFILE_MAX_ACCEL    6000.0f // counts/s^2
+#define STEER_PROFILE_MAX_JERK     0.0f    // counts/s^3, 0 = trapezoidal
+
+/* ================== Calibration ================== */
+#define STEER_CALIB_DUTY          0.9f   // duty while sweeping to the mechanical stops
+#define STEER_CALIB_PULSE_MS      10U    // drive part of each sweep step
+#define STEER_CALIB_PERIOD_MS     30U    // one sweep step, the encoder is sampled once per step
+#define STEER_CALIB_STILL_COUNTS  20     // less movement than this counts as stalled
+#define STEER_CALIB_STALL_SAMPLES 50U    // stalled samples in a row that mark a stop
+#define STEER_CALIB_PAUSE_MS      500U   // rest at each stop
+#define STEER_CALIB_TIMEOUT_MS    20000U // give up on a side that never stalls
+#define STEER_CALIB_VERSION       2U     // stored record layout, bump when it changes
+#define STEER_STALL_REHOME_MS     300U   // full duty without moving this long re-homes a trusted record
+
+// 1: with a stored record, still find the left stop at boot before steering
+// (seconds, drives into the stop). 0: trust the record at once
+#ifndef STEER_BOOT_REHOME
+#define STEER_BOOT_REHOME 0
+#endif
+
 /* ================== Public API ================== */
 
 /**
- * @brief Initialize encoder and motor calibration
- *        - Moves motor to left and right limits
- *        - Finds encoder min, max, and center
- *        - Returns to center position
+ * @brief Start calibration, returns at once. Needs Encoder_Init first.
+ *        - With a valid record in flash (CalibStore) the steering is taken
+ *          to rest at the stored center and accepts commands at once. Should
+ *          the position loop then drive at full duty without moving, the
+ *          counter origin was wrong and the left stop is found again
+ *          (Motor_Angle_Rehome). STEER_BOOT_REHOME homes at boot instead.
+ *        - Otherwise the control tick moves to the left and right limits,
+ *          finds encoder min, max and center, and saves them
+ *        - Returns to center position, or to the angle last requested meanwhile
  */
 void Motor_Init_Angle(void);
 
 /**
- * @brief Stop motor immediately (0% PWM).
+ * @brief Discard the stored calibration and run the full sweep again.
+ *        The result replaces the flash record once finished.
+ */
+void Motor_Angle_Recalibrate(void);
+
+/**
+ * @brief Re-reference the encoder against the left stop, keeping the known
+ *        span (full sweep if there is none yet). For when the counter may
+ *        have missed movement, e.g. after Stop mode.
+ */
+void Motor_Angle_Rehome(void);
+
+/**
+ * @brief 1 once the steering range is known. Until then Motor_GotoAngle
+ *        only remembers the latest request.
+ */
+uint8_t Motor_Angle_IsCalibrated(void);
+
+/**
+ * @brief Main loop housekeeping: writes a new calibration to flash once the
+ *        steering is at its target and both wheels are stopped. Kept out of
+ *        the control tick, programming stalls the CPU.
+ */
+void Motor_Angle_Process(void);
+
+/**
+ * @brief Stop motor immediately (0% PWM) and stop tracking the target.
  */
 void Motor_Angle_Stop(void);
 
@@ -31,11 +93,18 @@ void Motor_Angle_Stop(void);
 void Motor_Run(uint8_t speed_percent, uint8_t direction);
 
 /**
- * @brief Move motor until encoder = target value (low-level).
+ * @brief Keep the steering where it is now: retargets the position loop to
+ *        the current count and drops a steering command waiting for calibration.
+ */
+void Motor_Angle_Hold(void);
+
+/**
+ * @brief Set the encoder count the position loop tracks (low-level).
+ *        Returns at once, targets outside the calibrated range are clamped.
  * 
  * @param target : encoder count value to reach
  */
-void Motor_GotoEncoder(int32_t target, uint8_t direction);
+void Motor_GotoEncoder(int32_t target);
 
 /**
  * @brief Move motor to specific angle relative to center.
@@ -45,12 +114,25 @@ void Motor_GotoEncoder(int32_t target, uint8_t direction);
  */
 void Motor_GotoAngle(uint8_t angle_deg, uint8_t direction);
 
-/* ================== Encoder API ================== */
+/**
+ * @brief 1 once the profile has finished and the encoder is within
+ *        STEER_DEADBAND_COUNTS of the target.
+ */
+uint8_t Motor_Angle_AtTarget(void);
+
+/**
+ * @brief Change the steering trajectory limits at runtime (encoder counts
+ *        and seconds). Invalid limits are ignored; maxJerk 0 = trapezoidal.
+ */
+void Motor_Angle_SetProfileLimits(const MotionLimits *limits);
 
 /**
- * @brief Initialize encoder timer.
+ * @brief One step of the PID position loop (CMSIS-DSP arm_pid_f32).
+ *        Called at STEER_CONTROL_HZ from HAL_TIM_PeriodElapsedCallback.
  */
-void Encoder_Init(TIM_HandleTypeDef *htim);
+void Motor_Angle_ControlTick(void);
+
+/* ================== Encoder API ================== */
 
 /**
  * @brief Get current encoder angle in degrees.
@@ -17,17 +17,40 @@ extern "C" {
 
 #endif
 
+#include "PacketCodec.h"
+
 // --- C-Compatible Part ---
 // This section can be understood by both C and C++ compilers.
 #define PAYLOAD_SIZE 4
 
+// Payload bytes on the wire for each packet type
+#define MOTOR_PAYLOAD_SIZE            3 // ID, speed, direction
+#define MOTOR_ANGLE_PAYLOAD_SIZE      4 // ID, angle (int16 LE), direction
+#define CAR_HORN_PAYLOAD_SIZE         3 // ID, duration, pattern
+#define CAR_LIGHT_PAYLOAD_SIZE        2 // ID, lightStatus
+#define CAR_CONFIRMATION_PAYLOAD_SIZE 4 // ID, packetID, confirmationStatus, value
+#define MOTOR_RPM_PAYLOAD_SIZE        3 // ID, rpm (int16 LE, negative = reverse)
+#define MOTOR_TIMED_PAYLOAD_SIZE      5 // ID, speed, direction, duration ms (uint16 LE)
+#define MOTOR_CALIBRATE_PAYLOAD_SIZE  1 // ID (steering motor 1)
+#define HEARTBEAT_PAYLOAD_SIZE        0 // keeps the deadman fed while idle
+#define PWM_MODE_PAYLOAD_SIZE         2 // ID, inaudible (0 = PWM_OUT_AUDIBLE_HZ, 1 = PWM_OUT_INAUDIBLE_HZ)
+
+// CarBatch payload: count, then count records of [packetID][payload]
+#define BATCH_MAX_COMMANDS 6
+
 // Use a C-style 'typedef enum' for compatibility.
 typedef enum {
     Motor_ID = 0x01,
     MotorAngle_ID = 0x02,
     CarHorn_ID = 0x03,
     CarLight_ID = 0x04,
-    CarConfirmation_ID = 0x05
+    CarConfirmation_ID = 0x05,
+    CarBatch_ID = 0x06,
+    MotorRpm_ID = 0x07,
+    MotorTimed_ID = 0x08,
+    MotorCalibrate_ID = 0x09,
+    Heartbeat_ID = 0x0A,
+    PwmMode_ID = 0x0B
 } PacketID;
 
 // These structs are C-compatible.
@@ -43,12 +66,30 @@ struct MotorAngle {
 };
 struct CarHorn {
     uint8_t ID;
-    uint8_t duartion;
+    uint8_t duartion;  // s the pattern repeats for, 0 = once
+    uint8_t pattern;   // HornPattern
 };
 struct CarLight {
     uint8_t ID;
     uint8_t lightStatus;
 };
+struct MotorRpm {
+    uint8_t ID;        // Motor 1, 2 or 3 = both
+    int16_t rpm;       // closed-loop target, negative = reverse
+};
+struct MotorTimed {
+    uint8_t ID;        // Motor 1, 2 or 3 = both
+    uint8_t speed;     // 0-100% duty
+    uint8_t direction; // 0=Backward, 1=Forward
+    uint16_t duration; // ms, 0 = run until the next command
+};
+struct MotorCalibrate {
+    uint8_t ID;        // steering motor, always 1
+};
+struct PwmMode {
+    uint8_t ID;        // always 1
+    uint8_t inaudible; // 1 = carrier above hearing, 0 = low-loss audible carrier
+};
 struct CarConfirmation {
     uint8_t ID;
     uint8_t packetID;
@@ -56,21 +97,24 @@ struct CarConfirmation {
     uint8_t value;
 };
 
-// The main Packet struct is also C-compatible.
-struct Packet {
-    uint16_t start_packet;
-    uint8_t packetID;
-    uint8_t payload[4];
-    uint8_t count;
-    uint16_t checksum;
-    uint16_t end_packet;
-};
+// Cycles spent looking up, validating and decoding single commands (DWT, handler excluded)
+typedef struct {
+    uint32_t dispatched;
+    uint32_t lastCycles;
+    uint32_t maxCycles;
+    uint64_t totalCycles; // totalCycles / dispatched = average
+} PacketDispatchStats;
 
 // This function declaration is C-compatible and can be called from uart.c or main.cpp.
-// Note the use of 'struct Packet' for strict C compatibility.
-uint16_t FillData(const uint8_t payload[PAYLOAD_SIZE], PacketID packetID);
+// Frames are built and decoded by PacketCodec, see PacketCodec.h for the wire layout.
+// CRC of a frame carrying len payload bytes, 0 if len exceeds PACKET_MAX_PAYLOAD
+uint16_t FillData(const uint8_t *payload, uint8_t len, PacketID packetID);
 uint16_t FillData_MotorAngle(uint8_t id, int16_t angle, uint8_t direction) ;
-uint8_t SerializePacket(const struct Packet *packet);
+uint8_t SerializePacket(const PacketView *packet);
+// Payload bytes expected for packetID, 0 if unknown, variable (CarBatch) or empty (Heartbeat)
+uint8_t Packet_PayloadSize(uint8_t packetID);
+// Snapshot of the dispatch timing, needs CycleCounter_Init at start up
+void Packet_GetDispatchStats(PacketDispatchStats *stats);
 // uint16_t FillData(const uint8_t payload[PAYLOAD_SIZE], PacketID packetID)
 
 
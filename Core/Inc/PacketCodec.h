@@ -0,0 +1,97 @@
+#ifndef PACKET_CODEC_H
+#define PACKET_CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Wire layout (byte offsets, multi-byte fields little endian, no padding):
+ *
+ *   0  start marker  0x55 0xAA
+ *   2  seq           sender's frame sequence number, wraps at 255
+ *   3  packetID
+ *   4  len           payload bytes
+ *   5  payload[len]
+ *   5+len  crc16     over seq, packetID, len and payload
+ *   7+len  end marker 0x0A 0x0D
+ */
+#define PACKET_START_MARKER 0xAA55
+#define PACKET_END_MARKER   0x0D0A
+#define PACKET_ID_NONE      0x00 // no packet type has it, for responses to unknown frames
+
+#define PACKET_OFFSET_START   0
+#define PACKET_OFFSET_SEQ     2
+#define PACKET_OFFSET_ID      3
+#define PACKET_OFFSET_LEN     4
+#define PACKET_OFFSET_PAYLOAD 5
+#define PACKET_HEADER_SIZE    PACKET_OFFSET_PAYLOAD
+#define PACKET_CRC_SIZE       2
+#define PACKET_END_SIZE       2
+#define PACKET_OVERHEAD       (PACKET_HEADER_SIZE + PACKET_CRC_SIZE + PACKET_END_SIZE)
+
+#define PACKET_MAX_PAYLOAD    23
+#define PACKET_MAX_FRAME_SIZE (PACKET_OVERHEAD + PACKET_MAX_PAYLOAD)
+
+/* Decoded frame. payload points into the receive buffer, nothing is copied. */
+typedef struct
+{
+    uint8_t seq;
+    uint8_t packetID;
+    uint8_t len;
+    const uint8_t *payload;
+} PacketView;
+
+/* ================== Field Access ================== */
+
+static inline uint16_t PacketCodec_GetU16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static inline int16_t PacketCodec_GetI16(const uint8_t *p)
+{
+    return (int16_t)PacketCodec_GetU16(p);
+}
+
+static inline void PacketCodec_PutU16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)(value & 0xFF);
+    p[1] = (uint8_t)(value >> 8);
+}
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Total frame length from a received header (PACKET_HEADER_SIZE bytes).
+ * @return length in bytes, 0 if len is out of range
+ */
+uint16_t PacketCodec_FrameLength(const uint8_t *header);
+
+/**
+ * @brief Check markers, length and CRC of a received frame and map its fields.
+ *
+ * @param frame    : received frame, must stay valid while view is used
+ * @param frameLen : bytes in frame
+ * @param view     : filled on success; on failure seq and packetID are still
+ *                   filled from the header bytes (best effort, 0 and
+ *                   PACKET_ID_NONE if too short) so the frame can be NACKed
+ * @return 0 OK, 1 invalid start/end marker or length, 2 checksum mismatch
+ */
+uint8_t PacketCodec_Decode(const uint8_t *frame, uint16_t frameLen, PacketView *view);
+
+/**
+ * @brief Build a complete frame.
+ *
+ * @param frame : output, at least PACKET_OVERHEAD + len bytes
+ * @return frame length in bytes, 0 if len exceeds PACKET_MAX_PAYLOAD
+ */
+uint16_t PacketCodec_Encode(uint8_t *frame, uint8_t seq, uint8_t packetID, const uint8_t *payload, uint8_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PACKET_CODEC_H
@@ -0,0 +1,75 @@
+#ifndef POWER_H
+#define POWER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Low-power idle and parking.
+ *
+ * Idle: when no loop task is ready the main loop calls Power_Idle, which
+ * sleeps the core with WFI until the next interrupt (TIM10 tick, UART,
+ * DMA). Interrupts stay masked across the check and the WFI, so a task
+ * released just before cannot be slept over. The time spent asleep is
+ * read from the TIM10 counter (1 us per count) and accumulated for the
+ * CPU load report. The DWT cycle counter stops during the WFI, see
+ * CycleCounter.h.
+ *
+ * Power_Init trims the clocks: only the peripherals the firmware uses
+ * stay clocked in Sleep mode, and the unused GPIOC / GPIOH pins are set
+ * to analog (no input buffer leakage) with their port clocks off.
+ *
+ * Parking (POWER_STOP_ENABLE): Stop mode halts every clock, so the
+ * caller stops all PWM and the TIM10 tick first, and re-runs
+ * SystemClock_Config and Exec_Restart afterwards.
+ * The USART cannot wake the F401 from Stop; the RX pin (PA3) is turned
+ * into a falling-edge wakeup event instead. The frame carrying that
+ * edge is lost, the host retransmits it.
+ */
+
+// 1: park in Stop mode after POWER_PARK_MS without a frame
+#ifndef POWER_STOP_ENABLE
+#define POWER_STOP_ENABLE 0
+#endif
+
+#define POWER_PARK_MS 60000U // link silence before parking
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Gate the clocks of unused peripherals, see above.
+ *        Called once after the MX_*_Init functions.
+ */
+void Power_Init(void);
+
+/**
+ * @brief Sleep until the next interrupt unless a loop task is pending.
+ *        Called from the main loop when Exec_RunLoop found nothing to do.
+ */
+void Power_Idle(void);
+
+/**
+ * @brief Microseconds spent in Power_Idle since boot (wraps after ~71 min,
+ *        use differences).
+ */
+uint32_t Power_GetIdleUs(void);
+
+/**
+ * @brief Enter Stop mode, returns once a falling edge on the command
+ *        link RX pin wakes the core. The system clock is HSI afterwards.
+ */
+void Power_EnterStop(void);
+
+/**
+ * @brief Wakeup edge seen on the RX pin. Called from HAL_GPIO_EXTI_Callback.
+ */
+void Power_OnWakeEdge(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POWER_H
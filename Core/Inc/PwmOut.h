@@ -0,0 +1,108 @@
+#ifndef PWM_OUT_H
+#define PWM_OUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Output stage for the three motor channels on TIM4. Motor code sets a
+ * signed duty target; PwmOut_Tick moves the applied duty towards it at
+ * no more than the channel's slew rate. A sign change ramps down to 0,
+ * flips the direction pin while the output is off, then ramps up again.
+ * Compare registers are preloaded (OCxPE) and the auto-reload too (ARPE),
+ * so new values take effect on the next update event, never mid-period.
+ *
+ * The PWM frequency is set at runtime by PwmOut_Configure, which picks
+ * the prescaler and period from the live TIM4 clock. Duties are kept as
+ * fractions of full scale, so they carry over to the new period.
+ */
+
+typedef enum
+{
+    PWM_OUT_STEER = 0, // TIM4 CH1, direction PB7
+    PWM_OUT_WHEEL1,    // TIM4 CH3, direction PB4
+    PWM_OUT_WHEEL2,    // TIM4 CH4, direction PB5
+    PWM_OUT_COUNT
+} PwmOutChannel;
+
+// Default slew limits, duty (full scale = 1) per second
+#define PWM_OUT_STEER_SLEW 200.0f // 5 ms to full scale, calibration pulses are 10 ms
+#define PWM_OUT_WHEEL_SLEW 5.0f   // 200 ms to full scale
+#define PWM_OUT_TICK_HZ    1000U  // PwmOut_Tick rate (control tick)
+
+/* ================== Frequency ================== */
+#define PWM_OUT_MIN_STEPS    500U   // duty resolution the control loops need (~9 bits)
+#define PWM_OUT_AUDIBLE_HZ   4000U  // lower switching losses in the H-bridges, but whines
+#define PWM_OUT_INAUDIBLE_HZ 25000U // above hearing, 640 steps at 16 MHz, 3360 at 84 MHz
+
+// Start-up mode: 1 = PWM_OUT_INAUDIBLE_HZ, 0 = PWM_OUT_AUDIBLE_HZ.
+// The host switches at runtime with the PwmMode packet (PwmOut_SetInaudible)
+#ifndef PWM_OUT_INAUDIBLE
+#define PWM_OUT_INAUDIBLE 1
+#endif
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Start the PWM channels at 0 with the default slew limits and frequency.
+ */
+void PwmOut_Init(void);
+
+/**
+ * @brief Set the PWM frequency, keeping at least minSteps of duty resolution.
+ *        Uses the smallest prescaler (finest resolution) that reaches the
+ *        frequency. Prescaler, period and every compare register switch
+ *        together on one update event; running duties are rescaled.
+ *        Call again after a system clock change.
+ *
+ * @return 1 on success, 0 if the frequency cannot be met with minSteps
+ *         (the configuration is left unchanged)
+ */
+uint8_t PwmOut_Configure(uint32_t frequencyHz, uint16_t minSteps);
+
+/**
+ * @brief Move the motor PWM above the audible range (PWM_OUT_INAUDIBLE_HZ),
+ *        or back to PWM_OUT_AUDIBLE_HZ.
+ */
+uint8_t PwmOut_SetInaudible(uint8_t enable);
+
+/**
+ * @brief Frequency and number of duty steps currently configured.
+ */
+void PwmOut_GetConfig(uint32_t *frequencyHz, uint32_t *steps);
+
+/**
+ * @brief New duty target, reached by PwmOut_Tick within the slew limit.
+ * @param duty : [-1..1], the sign selects the direction pin (positive = pin set)
+ */
+void PwmOut_Set(PwmOutChannel ch, float duty);
+
+/**
+ * @brief Output to 0 at once, bypassing the ramp (emergency stop).
+ */
+void PwmOut_Stop(PwmOutChannel ch);
+
+/**
+ * @brief Change a channel's slew limit in duty per second, 0 = unlimited.
+ */
+void PwmOut_SetSlewRate(PwmOutChannel ch, float dutyPerSecond);
+
+/**
+ * @brief Duty currently applied (signed), which may still lag the target.
+ */
+float PwmOut_Get(PwmOutChannel ch);
+
+/**
+ * @brief Step every channel towards its target and write the compare
+ *        registers. Called at PWM_OUT_TICK_HZ, after the control loops.
+ */
+void PwmOut_Tick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_OUT_H
@@ -0,0 +1,80 @@
+#ifndef RTOS_APP_H
+#define RTOS_APP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * CMSIS-RTOS2 threaded variant of the firmware, built with UART_CAR_RTOS
+ * (see CMakeLists.txt). It replaces the Exec task table; the task bodies
+ * in main.c are shared by both variants.
+ *
+ * Threads, highest priority first:
+ *   control   - released by the TIM10 1 kHz interrupt: encoders, steering
+ *               and speed loops, then one telemetry sample every
+ *               RTOS_APP_TELEMETRY_DIVIDER releases into the telemetry queue
+ *   actuators - released by control after each run: soft timers, deadman,
+ *               PWM output stage
+ *   link      - released by the UART RX interrupts: frame decode, dispatch
+ *               and responses; housekeeping runs here too, between frames,
+ *               so it never overlaps a command as in the Exec variant
+ *   log       - drains the telemetry queue onto the debug log
+ *
+ * Priorities keep the preemption order of the Exec variant (control and
+ * actuators used to be the tick interrupt, link the main loop), so the
+ * PRIMASK critical sections the modules already use stay sufficient.
+ *
+ * SysTick belongs to the kernel: the HAL time base moves to TIM11
+ * (stm32f4xx_hal_timebase_tim.c), and HAL_Delay sleeps the calling thread
+ * instead of spinning once the kernel runs. Interrupts that release
+ * threads are lowered to RTOS_APP_IRQ_PRIORITY so they may call the
+ * kernel (FreeRTOS: configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY).
+ */
+
+#define RTOS_APP_IRQ_PRIORITY       5U  // TIM10, USART2 and its RX DMA stream
+#define RTOS_APP_TELEMETRY_DIVIDER  20U // control releases per sample (50 Hz)
+#define RTOS_APP_TELEMETRY_DEPTH    8U  // samples queued for the log thread
+#define RTOS_APP_HOUSEKEEPING_MS    100U
+
+typedef struct
+{
+    void (*control)(void);      // every TIM10 tick
+    void (*actuators)(void);    // after each control run
+    void (*commands)(void);     // drain the frame queue
+    void (*housekeeping)(void); // every RTOS_APP_HOUSEKEEPING_MS
+} RtosAppTasks;
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Create the threads and queues and start the kernel, does not
+ *        return. Called at the end of main() once every module is
+ *        initialised; TIM10 is started by the control thread.
+ *
+ * @param tasks : bodies run by the threads, kept by reference
+ */
+void RtosApp_Start(const RtosAppTasks *tasks);
+
+/**
+ * @brief Release the control thread. Called from the TIM10 update interrupt.
+ */
+void RtosApp_OnTick(void);
+
+/**
+ * @brief Wake the link thread. Called from the USART2 RX callbacks.
+ */
+void RtosApp_OnRx(void);
+
+/**
+ * @brief Telemetry samples dropped because the log thread fell behind.
+ */
+uint32_t RtosApp_GetTelemetryDrops(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RTOS_APP_H
@@ -0,0 +1,45 @@
+#ifndef RX_RING_H
+#define RX_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Read side of a circular DMA receive buffer, HAL-free.
+ * The DMA reports how far it has written (head, 0..size; size on a
+ * transfer-complete wrap); the reader keeps the position of the first
+ * byte it has not handed on yet (tail, 0..size-1). The new bytes are
+ * one span, or two when the DMA wrapped since the last event.
+ */
+
+typedef struct
+{
+    uint16_t start; // index of the first new byte in the buffer
+    uint16_t len;   // bytes from start, never past the end of the buffer
+} RxSpan;
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Work out which bytes the DMA wrote since the last event and
+ *        advance the tail past them.
+ *
+ * head == tail means nothing new (an IDLE event right after a TC event).
+ * A full lap (tail 0, head size) comes out as one span of the whole buffer.
+ *
+ * @param tail  : reader position, updated (wraps to 0 at the end of the buffer)
+ * @param head  : DMA write position [0..size]
+ * @param size  : buffer length in bytes
+ * @param spans : filled with up to two spans, in receive order
+ * @return number of spans filled (0..2), 0 if head is out of range
+ */
+uint8_t RxRing_Advance(uint16_t *tail, uint16_t head, uint16_t size, RxSpan spans[2]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RX_RING_H
@@ -0,0 +1,60 @@
+#ifndef SOFT_TIMER_H
+#define SOFT_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * One-shot millisecond timers driven by the 1 kHz control tick.
+ * Each user owns a fixed slot; starting a running slot supersedes it.
+ * Callbacks run in the tick interrupt and must stay short.
+ */
+
+typedef enum
+{
+    SOFT_TIMER_MOTOR1 = 0,
+    SOFT_TIMER_MOTOR2,
+    SOFT_TIMER_HORN,
+    SOFT_TIMER_COUNT
+} SoftTimerId;
+
+typedef void (*SoftTimerCallback)(void *arg);
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Stop every timer.
+ */
+void SoftTimer_Init(void);
+
+/**
+ * @brief (Re)start a timer, a pending expiry of the same slot is dropped.
+ *
+ * @param ms       : delay in ms, 0 stops the timer instead
+ * @param callback : run once when the delay has elapsed
+ */
+void SoftTimer_Start(SoftTimerId id, uint32_t ms, SoftTimerCallback callback, void *arg);
+
+/**
+ * @brief Cancel a timer without running its callback.
+ */
+void SoftTimer_Stop(SoftTimerId id);
+
+/**
+ * @brief 1 while the timer is counting down.
+ */
+uint8_t SoftTimer_IsRunning(SoftTimerId id);
+
+/**
+ * @brief Advance all timers by 1 ms. Called from the 1 kHz control tick.
+ */
+void SoftTimer_Tick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SOFT_TIMER_H
@@ -8,41 +8,77 @@
 extern "C" {
 #endif
 
+// -------------------- Speed Control --------------------
+#define WHEEL_CONTROL_DIVIDER  5U      // executive ticks per speed sample
+#define WHEEL_CONTROL_HZ       200U    // 1 kHz control tick / WHEEL_CONTROL_DIVIDER
+#define WHEEL_COUNTS_PER_REV   2048U   // encoder counts per wheel revolution (x4 decoding)
+#define WHEEL_MAX_RPM          300.0f  // rpm at 100% duty, feed-forward scale
+#define WHEEL_KP               0.002f  // duty per rpm of error
+#define WHEEL_KI               0.0005f // per sample
+#define WHEEL_KD               0.0f
+
+#define MOTOR_DEFAULT_PULSE_MS 500U    // run time of the legacy Motor packet
+
 // -------------------- Public API --------------------
 
+void Motor_init();
+
 /**
- * @brief Read encoder position (counter value).
- * @param motorID  Motor index: 1 = Motor1 (TIM2), 2 = Motor2 (TIM5)
- * @return Signed 16-bit encoder count
+ * @brief Set motor speed and direction for MOTOR_DEFAULT_PULSE_MS, returns at once.
+ * @param motorID   Motor index: 1, 2 or 3 (both)
+ * @param speed     Duty cycle % (0–100)
+ * @param direction 0 = one direction, 1 = opposite
  */
-int32_t Encoder_ReadPosition(uint8_t motorID);
+void Motor_SetSpeed(uint8_t motorID, uint8_t speed, uint8_t direction);
 
 /**
- * @brief Read encoder speed in RPM.
- * @param motorID         Motor index: 1 or 2
- * @param counts_per_rev  Encoder resolution (pulses per revolution)
- * @param dt_sec          Sampling interval in seconds
- * @return Speed in RPM
+ * @brief Open-loop run, returns at once. A later command on the same
+ *        motor supersedes this one without a gap.
+ * @param motorID     Motor index: 1, 2 or 3 (both)
+ * @param speed       Duty cycle % (0–100)
+ * @param direction   0 = one direction, 1 = opposite
+ * @param duration_ms Stop after this many ms, 0 = run until superseded
  */
-float Encoder_ReadSpeed(uint8_t motorID, uint16_t counts_per_rev, float dt_sec);
+void Motor_Drive(uint8_t motorID, uint8_t speed, uint8_t direction, uint16_t duration_ms);
 
+/**
+ * @brief Hold a wheel speed in closed loop, returns at once.
+ * @param motorID Motor index: 1, 2 or 3 (both)
+ * @param rpm     Target speed, negative = reverse, 0 stops the motor
+ */
+void Motor_SetRpm(uint8_t motorID, int16_t rpm);
 
-void Motor_init();
+/**
+ * @brief Last measured wheel speed in RPM.
+ * @param motorID Motor index: 1 or 2
+ */
+float Motor_GetRpm(uint8_t motorID);
 
 /**
- * @brief Set motor speed and direction.
- * @param motorID   Motor index: 1 or 2
- * @param speed     Duty cycle % (0–100)
- * @param direction 0 = one direction, 1 = opposite
+ * @brief One step of the wheel speed loops. Run by the executive every
+ *        WHEEL_CONTROL_DIVIDER ticks (WHEEL_CONTROL_HZ).
  */
-void Motor_SetSpeed(uint8_t motorID, uint8_t speed, uint8_t direction);
+void Motor_SpeedControlTick(void);
 
 /**
- * @brief Stop a motor (set PWM = 0).
- * @param motorID Motor index: 1 or 2
+ * @brief Stop a motor (PWM target 0, ramped by PwmOut), cancels timed runs and speed control.
+ * @param motorID Motor index: 1, 2 or 3 (both)
  */
 void Motor_Stop(uint8_t motorID);
 
+/**
+ * @brief Ramp the PWM down to 0 from the speed loop, returns at once.
+ *        Cancels timed runs and speed control; a new command takes over.
+ * @param motorID Motor index: 1, 2 or 3 (both)
+ * @param ramp_ms Time from full scale to zero, 0 stops at once
+ */
+void Motor_RampToStop(uint8_t motorID, uint16_t ramp_ms);
+
+/**
+ * @brief 1 when both wheels are at zero PWM (applied, after the output slew).
+ */
+uint8_t Motor_IsStopped(void);
+
 #ifdef __cplusplus
 }
 #endif
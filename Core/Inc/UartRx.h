@@ -0,0 +1,61 @@
+#ifndef UART_RX_H
+#define UART_RX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+#include "FrameParser.h"
+
+/* ================== Receive Mode ================== */
+#define UART_RX_MODE_IT   0   // one HAL_UART_Receive_IT interrupt per byte
+#define UART_RX_MODE_DMA  1   // circular DMA, frames picked up on IDLE line
+
+#ifndef UART_RX_MODE
+#define UART_RX_MODE UART_RX_MODE_DMA
+#endif
+
+// Circular DMA buffer, must hold at least a few back-to-back frames
+#define UART_RX_DMA_BUF_SIZE 64
+
+/* ================== Public API ================== */
+
+/**
+ * @brief Start reception on the command link in the selected UART_RX_MODE.
+ *        Frames validated by the FrameParser are pushed to the FrameQueue.
+ * @param huart : command link handle (USART2)
+ */
+void UartRx_Init(UART_HandleTypeDef *huart);
+
+/**
+ * @brief Feed the bytes written by DMA since the last call to the framer.
+ *        Called from HAL_UARTEx_RxEventCallback (IDLE line / transfer complete).
+ *
+ * @param head : DMA write position in the circular buffer [0..UART_RX_DMA_BUF_SIZE]
+ */
+void UartRx_OnEvent(uint16_t head);
+
+/**
+ * @brief Feed the byte received in interrupt mode and re-arm reception.
+ *        Called from HAL_UART_RxCpltCallback.
+ */
+void UartRx_OnRxCplt(void);
+
+/**
+ * @brief Restart reception after a UART error (overrun, framing, noise).
+ *        Called from HAL_UART_ErrorCallback.
+ */
+void UartRx_OnError(void);
+
+/**
+ * @brief Snapshot of the command link framing statistics (errors, resync latency).
+ */
+void UartRx_GetParserStats(FrameParserStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UART_RX_H
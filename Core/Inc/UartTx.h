@@ -0,0 +1,69 @@
+#ifndef UART_TX_H
+#define UART_TX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+/* ================== Configuration ================== */
+#define UART_TX_DEPTH      16  // responses, power of two
+#define UART_TX_SLOT_SIZE  40  // bytes per response, fits a frame or a debug text line
+
+typedef struct
+{
+    uint32_t depth;      // responses queued or on the wire
+    uint32_t highWater;  // max depth seen since init
+    uint32_t dropped;    // responses refused because the outbox was full or they were too long
+    uint32_t aborted;    // responses lost to a transmit error
+    uint32_t sent;       // responses fully transmitted
+} UartTxStats;
+
+/* ================== Public API ================== */
+/*
+ * Outbox for the command link, drained by DMA one slot at a time.
+ * Single producer (main loop) / single consumer (DMA transfer complete ISR).
+ * Data is copied into the outbox, the caller's buffer is free on return.
+ */
+
+/**
+ * @brief Empty the outbox and clear the counters.
+ * @param huart : command link handle (USART2), TX DMA linked
+ */
+void UartTx_Init(UART_HandleTypeDef *huart);
+
+/**
+ * @brief Queue bytes for transmission, never waits for the wire.
+ * @return 1 if queued, 0 if dropped (outbox full or len > UART_TX_SLOT_SIZE)
+ */
+uint8_t UartTx_Send(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Free slots left, lets callers hold back before UartTx_Send drops.
+ */
+uint32_t UartTx_Free(void);
+
+/**
+ * @brief Start the next queued slot once the previous one is on the wire.
+ *        Called from HAL_UART_TxCpltCallback.
+ */
+void UartTx_OnTxCplt(void);
+
+/**
+ * @brief Drop the slot of an aborted transfer and go on with the next one.
+ *        Called from HAL_UART_ErrorCallback.
+ */
+void UartTx_OnError(void);
+
+/**
+ * @brief Snapshot of outbox depth and drop counters.
+ */
+void UartTx_GetStats(UartTxStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UART_TX_H
@@ -0,0 +1,62 @@
+#include "Bench.h"
+#include "stm32f4xx_hal.h"
+#include "CycleCounter.h"
+#include "FrameParser.h"
+#include "Packet.h"
+#include "Log.h"
+
+static uint8_t reply[PACKET_MAX_FRAME_SIZE];
+static volatile uint8_t decodeResult;
+
+// What Task_Commands does with a frame, minus Link and the dispatch
+static void Bench_OnFrame(const uint8_t *frame, uint16_t len)
+{
+    PacketView packet;
+    decodeResult = PacketCodec_Decode(frame, len, &packet);
+    if (decodeResult != 0)
+        return;
+
+    const uint8_t confirmation[CAR_CONFIRMATION_PAYLOAD_SIZE] = {1, packet.packetID, 0, packet.seq};
+    PacketCodec_Encode(reply, packet.seq, CarConfirmation_ID, confirmation, sizeof(confirmation));
+}
+
+static const FrameParserConfig benchFraming = {
+    .startMarker = PACKET_START_MARKER,
+    .endMarker = PACKET_END_MARKER,
+    .headerLen = PACKET_HEADER_SIZE,
+    .lengthOf = PacketCodec_FrameLength,
+    .onFrame = Bench_OnFrame,
+};
+
+void Bench_Packet(void)
+{
+    // Steering motor 1 to 30 degrees, right
+    const uint8_t payload[MOTOR_ANGLE_PAYLOAD_SIZE] = {1, 30, 0, 1};
+    uint8_t frame[PACKET_MAX_FRAME_SIZE];
+    uint16_t frameLen = PacketCodec_Encode(frame, 0, MotorAngle_ID, payload, sizeof(payload));
+
+    static FrameParser parser;
+    FrameParser_Init(&parser, &benchFraming);
+
+    uint32_t minCycles = UINT32_MAX;
+    uint32_t totalCycles = 0;
+    uint32_t failures = 0;
+    for (uint32_t i = 0; i < BENCH_PACKET_COUNT; i++)
+    {
+        decodeResult = 0xFF;
+        uint32_t start = CycleCounter_Now();
+        FrameParser_Push(&parser, frame, frameLen);
+        uint32_t cycles = CycleCounter_Now() - start;
+
+        totalCycles += cycles;
+        if (cycles < minCycles)
+            minCycles = cycles;
+        if (decodeResult != 0)
+            failures++;
+    }
+
+    uint32_t avgCycles = totalCycles / BENCH_PACKET_COUNT;
+    uint32_t avgNs = (uint32_t)((uint64_t)avgCycles * 1000000000U / SystemCoreClock);
+    LOG(BENCH_PACKET, (int32_t)(SystemCoreClock / 1000000U), (int32_t)minCycles, (int32_t)avgCycles,
+        (int32_t)avgNs, (int32_t)failures);
+}
@@ -0,0 +1,119 @@
+#include "CalibStore.h"
+#include "CheckSum.h"
+#include "stm32f4xx_hal.h"
+#include <string.h>
+
+#define CALIB_STORE_ERASED 0xFFFFFFFFU
+#define CALIB_STORE_END    (CALIB_STORE_ADDR + CALIB_STORE_SIZE)
+
+#define RECORD_HEADER(version, words) (((uint32_t)CALIB_STORE_MAGIC << 16) | ((uint32_t)(version) << 8) | (words))
+#define RECORD_MAGIC(header)   ((header) >> 16)
+#define RECORD_VERSION(header) (((header) >> 8) & 0xFFU)
+#define RECORD_WORDS(header)   ((header) & 0xFFU)
+
+static inline uint32_t CalibStore_Word(uint32_t addr)
+{
+    return *(const volatile uint32_t *)addr;
+}
+
+// CRC over the header and data words, read straight from flash
+static uint16_t CalibStore_RecordCrc(uint32_t addr, uint8_t words)
+{
+    return crc16_table_calc((const uint8_t *)addr, 4U * (1U + words));
+}
+
+/**
+ * Walk the records. Returns the address of the latest good one (0 if none)
+ * and sets *freeAddr to where the next record goes, or CALIB_STORE_END if
+ * the sector holds something that is not a record and must be erased.
+ */
+static uint32_t CalibStore_Scan(uint32_t *freeAddr)
+{
+    uint32_t addr = CALIB_STORE_ADDR;
+    uint32_t latest = 0;
+
+    while (addr < CALIB_STORE_END)
+    {
+        uint32_t header = CalibStore_Word(addr);
+        if (header == CALIB_STORE_ERASED)
+            break;
+
+        uint8_t words = RECORD_WORDS(header);
+        uint32_t crcAddr = addr + 4U * (1U + words);
+        if (RECORD_MAGIC(header) != CALIB_STORE_MAGIC || crcAddr >= CALIB_STORE_END)
+        {
+            addr = CALIB_STORE_END;
+            break;
+        }
+
+        // A torn write fails its CRC and is skipped, the one before it stays valid
+        if ((CalibStore_Word(crcAddr) & 0xFFFFU) == CalibStore_RecordCrc(addr, words))
+            latest = addr;
+        addr = crcAddr + 4U;
+    }
+
+    *freeAddr = addr;
+    return latest;
+}
+
+static uint8_t CalibStore_Erase(void)
+{
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase = FLASH_TYPEERASE_SECTORS,
+        .Sector = CALIB_STORE_SECTOR,
+        .NbSectors = 1,
+        .VoltageRange = FLASH_VOLTAGE_RANGE_3, // 2.7-3.6 V, word programming
+    };
+    uint32_t badSector;
+
+    return HAL_FLASHEx_Erase(&erase, &badSector) == HAL_OK;
+}
+
+/* ==================== Public API ==================== */
+
+uint8_t CalibStore_Load(uint8_t version, void *data, uint16_t size)
+{
+    uint32_t freeAddr;
+    uint32_t record = CalibStore_Scan(&freeAddr);
+    if (record == 0)
+        return 0;
+
+    uint32_t header = CalibStore_Word(record);
+    if (RECORD_VERSION(header) != version || 4U * RECORD_WORDS(header) != size)
+        return 0;
+
+    memcpy(data, (const void *)(record + 4U), size);
+    return 1;
+}
+
+uint8_t CalibStore_Save(uint8_t version, const void *data, uint16_t size)
+{
+    uint8_t words = (uint8_t)(size / 4U);
+    uint32_t recordSize = 4U * (2U + words);
+    if (size % 4U != 0 || size > CALIB_STORE_MAX_SIZE)
+        return 0;
+
+    uint32_t addr;
+    CalibStore_Scan(&addr);
+
+    HAL_FLASH_Unlock();
+    uint8_t ok = 1;
+    if (addr + recordSize > CALIB_STORE_END)
+    {
+        ok = CalibStore_Erase();
+        addr = CALIB_STORE_ADDR;
+    }
+
+    // The CRC covers exactly the words about to be written, compute it from RAM
+    uint32_t record[2U + CALIB_STORE_MAX_SIZE / 4U];
+    record[0] = RECORD_HEADER(version, words);
+    memcpy(&record[1], data, size);
+    record[1U + words] = crc16_table_calc((const uint8_t *)record, 4U * (1U + words));
+
+    for (uint8_t i = 0; ok && i < 2U + words; i++)
+        ok = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + 4U * i, record[i]) == HAL_OK;
+    HAL_FLASH_Lock();
+
+    // Read back through the same path Load uses
+    return ok && (CalibStore_Word(addr + 4U * (1U + words)) & 0xFFFFU) == CalibStore_RecordCrc(addr, words);
+}
@@ -1,6 +1,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "CheckSum.h"
+#include "Clock.h"
 
 
 #define CRC16_POLY   0xA001  // reversed 0x8005
@@ -41,7 +42,7 @@ static const uint16_t crc16_table[256] = {
     0xC0AF, 0x60AE, 0x00AC, 0xA0AD, 0x00A8, 0xA0A9, 0xC0AB, 0x60AA
 };
 
-uint16_t crc16_table_calc(const uint8_t *data, size_t length) {
+HOT_FUNC uint16_t crc16_table_calc(const uint8_t *data, size_t length) {
     uint16_t crc = CRC16_INIT;
     for (size_t i = 0; i < length; i++) {
         uint8_t tbl_idx = (crc ^ data[i]) & 0xFF;
@@ -51,9 +52,5 @@ uint16_t crc16_table_calc(const uint8_t *data, size_t length) {
 }
 
 uint16_t checksum(uint8_t* myData,uint8_t size) {
-    uint16_t crc = crc16_table_calc(myData, size);
-    // printf("CRC-16: 0x%04X\n", crc);
-    uart_log_printf("CRC: %04X\r\n", crc);
-
-    return crc;
+    return crc16_table_calc(myData, size);
 }
\ No newline at end of file
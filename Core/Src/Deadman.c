@@ -0,0 +1,96 @@
+#include "Deadman.h"
+#include "Log.h"
+#include "Motor_Angle.h"
+#include "Speed_Motor.h"
+#include "stm32f4xx_hal.h"
+
+extern TIM_HandleTypeDef htim10;
+
+typedef enum
+{
+    DEADMAN_DISARMED = 0, // no frame yet, or disabled
+    DEADMAN_ARMED,
+    DEADMAN_TRIPPED,
+} DeadmanState;
+
+static volatile DeadmanState state = DEADMAN_DISARMED;
+static volatile uint32_t nowMs = 0;     // Deadman_Tick calls, keeps counting while the core sleeps
+static volatile uint32_t feedMs;        // nowMs at the last feed
+static volatile uint16_t timeoutMs = DEADMAN_TIMEOUT_MS;
+static uint32_t deadlineMs;             // nowMs when the timeout expired, for the stop time
+static uint8_t stopPending;             // tripped, wheels still ramping down
+static DeadmanStats stats;
+
+void Deadman_Init(void)
+{
+    state = DEADMAN_DISARMED;
+    timeoutMs = DEADMAN_TIMEOUT_MS;
+    stopPending = 0;
+}
+
+void Deadman_Feed(void)
+{
+    if (timeoutMs == 0)
+        return;
+
+    // Time first: the tick must never pair the armed state with an old feed
+    feedMs = nowMs;
+    state = DEADMAN_ARMED;
+}
+
+void Deadman_SetTimeout(uint16_t timeout_ms)
+{
+    timeoutMs = timeout_ms;
+    if (timeout_ms == 0)
+        state = DEADMAN_DISARMED;
+}
+
+uint8_t Deadman_IsTripped(void)
+{
+    return state == DEADMAN_TRIPPED;
+}
+
+void Deadman_Tick(void)
+{
+    uint32_t now = ++nowMs;
+
+    if (stopPending && Motor_IsStopped())
+    {
+        stopPending = 0;
+        stats.lastStopMs = now - deadlineMs;
+        LOG(DEADMAN_STOPPED, stats.lastStopMs);
+    }
+
+    if (state != DEADMAN_ARMED)
+        return;
+
+    // The feed came between two ticks: silence counts started ms, so more
+    // than timeoutMs of them means at least timeoutMs really passed
+    uint32_t silence = now - feedMs;
+    if (silence <= timeoutMs)
+        return;
+
+    state = DEADMAN_TRIPPED;
+    Motor_RampToStop(3, DEADMAN_RAMP_MS);
+    Motor_Angle_Hold();
+
+    deadlineMs = feedMs + timeoutMs;
+    stopPending = 1;
+
+    // The timeout expired during the last ms; how late this tick ran after its TIM10 update
+    uint32_t latencyUs = __HAL_TIM_GET_COUNTER(&htim10);
+    stats.trips++;
+    stats.lastLatencyUs = latencyUs;
+    if (latencyUs > stats.maxLatencyUs)
+        stats.maxLatencyUs = latencyUs;
+
+    LOG(DEADMAN_TRIP, timeoutMs, latencyUs);
+}
+
+void Deadman_GetStats(DeadmanStats *out)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = stats;
+    __set_PRIMASK(primask);
+}
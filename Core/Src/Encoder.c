@@ -0,0 +1,234 @@
+#include "Encoder.h"
+#include "stm32f4xx_hal.h"
+#include "arm_math.h"
+#include "Clock.h"
+
+extern TIM_HandleTypeDef htim2;
+extern TIM_HandleTypeDef htim3;
+extern TIM_HandleTypeDef htim5;
+extern TIM_HandleTypeDef htim10; // 1 us per count, one period per Encoder_Update
+
+#define ENCODER_UPDATE_US (1000000U / ENCODER_UPDATE_HZ)
+
+typedef struct
+{
+    TIM_HandleTypeDef *htim;
+    uint8_t is32Bit;     // TIM2 / TIM5; TIM3 is 16-bit
+    uint16_t edgePin;    // channel A on port A, its EXTI line timestamps edges
+    IRQn_Type edgeIrq;
+    uint32_t lastRaw;    // counter at the last update
+    int64_t position;    // counts up to lastRaw
+
+    // First A edge after the last update, written by Encoder_OnEdge
+    volatile uint8_t captured;
+    uint32_t captureRaw;    // encoder counter at the edge
+    uint16_t captureCnt;    // TIM10 counter at the edge
+    uint32_t armUs;         // time of the update that armed the EXTI line
+    uint16_t armCnt;        // TIM10 counter at that update
+
+    // M/T velocity: the window runs from one timestamped edge to the next
+    int64_t edgePosition;   // position at the latest timestamped edge
+    uint32_t edgeUs;
+    int64_t windowPosition; // edge the current window starts at
+    uint32_t windowUs;
+    float rawVelocity;      // counts/s
+    volatile float velocity;
+#if ENCODER_VELOCITY_FILTER
+    arm_biquad_casd_df1_inst_f32 filter;
+    float filterState[4];
+#endif
+} Encoder;
+
+// Updated by the control tick, read with interrupts masked elsewhere
+static Encoder encoders[ENCODER_COUNT] = {
+    [ENCODER_WHEEL1] = {.htim = &htim2, .is32Bit = 1, .edgePin = GPIO_PIN_15, .edgeIrq = EXTI15_10_IRQn},
+    [ENCODER_WHEEL2] = {.htim = &htim5, .is32Bit = 1, .edgePin = GPIO_PIN_0, .edgeIrq = EXTI0_IRQn},
+    [ENCODER_STEER] = {.htim = &htim3, .is32Bit = 0, .edgePin = GPIO_PIN_6, .edgeIrq = EXTI9_5_IRQn},
+};
+
+static uint32_t updateTick = 0;   // Encoder_Update calls, one per TIM10 period
+static uint32_t updateUs = 0;     // time of the last update, the M/T time base
+static uint8_t velocityDivider = 0;
+
+#if ENCODER_VELOCITY_FILTER
+// Butterworth low-pass, fc 20 Hz at fs ENCODER_VELOCITY_HZ (200 Hz): {b0, b1, b2, -a1, -a2}
+static const float velocityFilterCoeffs[5] = {
+    0.0674552739f, 0.1349105478f, 0.0674552739f, 1.1429805025f, -0.4128015981f,
+};
+#endif
+
+// Signed movement since lastRaw, at the counter's width so wraps cancel out
+static inline int32_t Encoder_Delta(const Encoder *enc, uint32_t raw)
+{
+    if (enc->is32Bit)
+        return (int32_t)(raw - enc->lastRaw);
+    return (int16_t)(uint16_t)(raw - enc->lastRaw);
+}
+
+// Route channel A to its EXTI line on both edges; the pin stays in its timer AF mode
+static void Encoder_InitEdgeLine(const Encoder *enc)
+{
+    uint32_t line = POSITION_VAL(enc->edgePin);
+    __HAL_RCC_SYSCFG_CLK_ENABLE();
+    SYSCFG->EXTICR[line >> 2] &= ~(0x0FU << (4U * (line & 3U))); // port A
+    EXTI->IMR &= ~enc->edgePin; // armed by Encoder_Update
+    EXTI->RTSR |= enc->edgePin;
+    EXTI->FTSR |= enc->edgePin;
+    HAL_NVIC_SetPriority(enc->edgeIrq, 0, 0);
+    HAL_NVIC_EnableIRQ(enc->edgeIrq);
+}
+
+void Encoder_Init(void)
+{
+    for (uint8_t i = 0; i < ENCODER_COUNT; i++)
+    {
+        Encoder *enc = &encoders[i];
+        HAL_TIM_Encoder_Start(enc->htim, TIM_CHANNEL_ALL);
+        __HAL_TIM_SET_COUNTER(enc->htim, 0);
+        Encoder_InitEdgeLine(enc);
+        enc->lastRaw = 0;
+        enc->position = 0;
+        enc->captured = 0;
+        enc->armUs = 0;
+        enc->armCnt = 0;
+        enc->edgePosition = 0;
+        enc->edgeUs = 0;
+        enc->windowPosition = 0;
+        enc->windowUs = 0;
+        enc->rawVelocity = 0.0f;
+        enc->velocity = 0.0f;
+#if ENCODER_VELOCITY_FILTER
+        arm_biquad_cascade_df1_init_f32(&enc->filter, 1, velocityFilterCoeffs, enc->filterState);
+#endif
+    }
+    updateTick = 0;
+    updateUs = 0;
+    velocityDivider = 0;
+}
+
+// One velocity sample, every ENCODER_VELOCITY_DIVIDER updates
+static void Encoder_SampleVelocity(Encoder *enc)
+{
+    int64_t counts = enc->edgePosition - enc->windowPosition;
+    uint32_t us = enc->edgeUs - enc->windowUs;
+
+    if (counts != 0 && us != 0)
+    {
+        // M/T: counts over the exact span between the window's edges
+        enc->rawVelocity = (float)counts * 1e6f / us;
+        enc->windowPosition = enc->edgePosition;
+        enc->windowUs = enc->edgeUs;
+    }
+    else
+    {
+        uint32_t idle = updateUs - enc->windowUs;
+        if (idle >= ENCODER_VELOCITY_TIMEOUT_MS * 1000U)
+        {
+            // Stopped: restart the window at the current position so the
+            // next edge is not timed from long ago
+            enc->rawVelocity = 0.0f;
+            enc->windowPosition = enc->position;
+            enc->windowUs = updateUs;
+            enc->edgePosition = enc->position;
+            enc->edgeUs = updateUs;
+        }
+        else
+        {
+            // No edge yet: the speed cannot be above one count over the idle time
+            float bound = 1e6f / idle;
+            if (fabsf(enc->rawVelocity) > bound)
+                enc->rawVelocity = (enc->rawVelocity > 0.0f) ? bound : -bound;
+        }
+    }
+
+#if ENCODER_VELOCITY_FILTER
+    float filtered;
+    arm_biquad_cascade_df1_f32(&enc->filter, &enc->rawVelocity, &filtered, 1);
+    enc->velocity = filtered;
+#else
+    enc->velocity = enc->rawVelocity;
+#endif
+}
+
+// Take the edge captured since the last update and arm the line for the next one
+static inline void Encoder_TakeEdge(Encoder *enc, uint16_t nowCnt)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (enc->captured)
+    {
+        // Less than one TIM10 period after the arming update
+        uint32_t sinceArm = (enc->captureCnt + ENCODER_UPDATE_US - enc->armCnt) % ENCODER_UPDATE_US;
+        enc->edgePosition = enc->position + Encoder_Delta(enc, enc->captureRaw);
+        enc->edgeUs = enc->armUs + sinceArm;
+        enc->captured = 0;
+    }
+    enc->armUs = updateUs;
+    enc->armCnt = nowCnt;
+    __HAL_GPIO_EXTI_CLEAR_IT(enc->edgePin);
+    EXTI->IMR |= enc->edgePin;
+    __set_PRIMASK(primask);
+}
+
+HOT_FUNC void Encoder_Update(void)
+{
+    uint16_t nowCnt = (uint16_t)__HAL_TIM_GET_COUNTER(&htim10);
+    updateTick++;
+    updateUs = updateTick * ENCODER_UPDATE_US + nowCnt;
+
+    uint8_t sample = (++velocityDivider >= ENCODER_VELOCITY_DIVIDER);
+    if (sample)
+        velocityDivider = 0;
+
+    for (uint8_t i = 0; i < ENCODER_COUNT; i++)
+    {
+        Encoder *enc = &encoders[i];
+        uint32_t raw = __HAL_TIM_GET_COUNTER(enc->htim);
+
+        // Before the position moves on, the captured counter is relative to lastRaw
+        Encoder_TakeEdge(enc, nowCnt);
+
+        enc->position += Encoder_Delta(enc, raw);
+        enc->lastRaw = raw;
+
+        if (sample)
+            Encoder_SampleVelocity(enc);
+    }
+}
+
+HOT_FUNC void Encoder_OnEdge(uint16_t pin)
+{
+    uint16_t cnt = (uint16_t)__HAL_TIM_GET_COUNTER(&htim10);
+
+    for (uint8_t i = 0; i < ENCODER_COUNT; i++)
+    {
+        Encoder *enc = &encoders[i];
+        if (enc->edgePin != pin)
+            continue;
+
+        enc->captureRaw = __HAL_TIM_GET_COUNTER(enc->htim);
+        enc->captureCnt = cnt;
+        // One edge per update is enough, keeps the interrupt rate at 1 kHz at any speed
+        EXTI->IMR &= ~pin;
+        enc->captured = 1;
+        return;
+    }
+}
+
+int64_t Encoder_GetPosition(EncoderId id)
+{
+    const Encoder *enc = &encoders[id];
+
+    // 64-bit position and lastRaw must come from the same update
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    int64_t position = enc->position + Encoder_Delta(enc, __HAL_TIM_GET_COUNTER(enc->htim));
+    __set_PRIMASK(primask);
+
+    return position;
+}
+
+float Encoder_GetVelocity(EncoderId id)
+{
+    return encoders[id].velocity;
+}
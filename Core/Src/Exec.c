@@ -0,0 +1,126 @@
+#include "Exec.h"
+#include "CycleCounter.h"
+#include "Clock.h"
+
+static const ExecTask *taskTable;
+static uint8_t taskCount = 0;
+
+// Per task, index as in the table
+static uint16_t countdown[EXEC_MAX_TASKS];        // ticks to the next release
+static volatile uint8_t pending[EXEC_MAX_TASKS];  // loop task released, not yet run
+static volatile uint32_t releaseCycles[EXEC_MAX_TASKS];
+static ExecTaskStats stats[EXEC_MAX_TASKS];
+
+static inline uint32_t Exec_CyclesPerTick(void)
+{
+    return SystemCoreClock / EXEC_TICK_HZ;
+}
+
+static void Exec_Account(uint8_t i, uint32_t start, uint32_t release, uint32_t end)
+{
+    uint32_t cycles = end - start;
+    stats[i].runs++;
+    stats[i].lastCycles = cycles;
+    if (cycles > stats[i].maxCycles)
+        stats[i].maxCycles = cycles;
+    if (end - release > taskTable[i].periodTicks * Exec_CyclesPerTick())
+        stats[i].misses++;
+}
+
+void Exec_Init(const ExecTask *tasks, uint8_t count)
+{
+    if (count > EXEC_MAX_TASKS)
+        count = EXEC_MAX_TASKS;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        countdown[i] = 1;
+        pending[i] = 0;
+        stats[i] = (ExecTaskStats){0};
+    }
+    taskTable = tasks;
+    taskCount = count;
+}
+
+HOT_FUNC void Exec_Tick(void)
+{
+    uint32_t tickStart = CycleCounter_Now();
+
+    for (uint8_t i = 0; i < taskCount; i++)
+    {
+        const ExecTask *task = &taskTable[i];
+        if (--countdown[i] != 0)
+            continue;
+        countdown[i] = task->periodTicks;
+
+        if (task->context == EXEC_IN_LOOP)
+        {
+            // Not run since the last release: that instance missed its deadline
+            if (pending[i])
+                stats[i].misses++;
+            releaseCycles[i] = tickStart;
+            pending[i] = 1;
+            continue;
+        }
+
+        uint32_t start = CycleCounter_Now();
+        task->run();
+        Exec_Account(i, start, tickStart, CycleCounter_Now());
+    }
+}
+
+uint8_t Exec_RunLoop(void)
+{
+    for (uint8_t i = 0; i < taskCount; i++)
+    {
+        if (!pending[i])
+            continue;
+
+        // Taken together, a release by the tick in between must not be lost
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        uint32_t release = releaseCycles[i];
+        pending[i] = 0;
+        __set_PRIMASK(primask);
+
+        uint32_t start = CycleCounter_Now();
+        taskTable[i].run();
+
+        // The tick adds misses to the same counters
+        __disable_irq();
+        Exec_Account(i, start, release, CycleCounter_Now());
+        __set_PRIMASK(primask);
+        return 1;
+    }
+    return 0;
+}
+
+void Exec_Restart(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (uint8_t i = 0; i < taskCount; i++)
+    {
+        countdown[i] = 1;
+        pending[i] = 0;
+    }
+    __set_PRIMASK(primask);
+}
+
+uint8_t Exec_HasPending(void)
+{
+    for (uint8_t i = 0; i < taskCount; i++)
+    {
+        if (pending[i])
+            return 1;
+    }
+    return 0;
+}
+
+void Exec_GetStats(uint8_t task, ExecTaskStats *out)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = stats[task];
+    __set_PRIMASK(primask);
+}
@@ -0,0 +1,118 @@
+#include "FrameParser.h"
+#include <string.h>
+#include "Clock.h"
+
+typedef enum
+{
+    BYTE_OK,
+    BYTE_FRAME_DONE,
+    BYTE_ERROR
+} ByteResult;
+
+/* ==================== Helpers ==================== */
+
+// Check buf[index] given that buf[0..index) already passed
+static ByteResult FrameParser_CheckByte(FrameParser *p, uint16_t index)
+{
+    const FrameParserConfig *cfg = p->config;
+    uint8_t byte = p->buf[index];
+
+    if (index == 0)
+        return (byte == (uint8_t)(cfg->startMarker & 0xFF)) ? BYTE_OK : BYTE_ERROR;
+    if (index == 1)
+        return (byte == (uint8_t)(cfg->startMarker >> 8)) ? BYTE_OK : BYTE_ERROR;
+
+    if (index + 1U == cfg->headerLen)
+    {
+        uint16_t len = cfg->lengthOf(p->buf);
+        if (len < (uint16_t)cfg->headerLen + 2U || len > FRAME_PARSER_MAX_LEN)
+            return BYTE_ERROR;
+        p->expected = len;
+    }
+
+    if (p->expected == 0)
+        return BYTE_OK;
+    if (index + 2U == p->expected)
+        return (byte == (uint8_t)(cfg->endMarker & 0xFF)) ? BYTE_OK : BYTE_ERROR;
+    if (index + 1U == p->expected)
+        return (byte == (uint8_t)(cfg->endMarker >> 8)) ? BYTE_FRAME_DONE : BYTE_ERROR;
+    return BYTE_OK;
+}
+
+// Remove the first n buffered bytes and start validating from scratch
+static void FrameParser_Drop(FrameParser *p, uint16_t n)
+{
+    memmove(p->buf, p->buf + n, p->count - n);
+    p->count -= n;
+    p->valid = 0;
+    p->expected = 0;
+}
+
+HOT_FUNC static void FrameParser_Run(FrameParser *p)
+{
+    // Each pass validates one byte or drops at least one, so this terminates
+    while (p->valid < p->count)
+    {
+        ByteResult r = FrameParser_CheckByte(p, p->valid);
+
+        if (r == BYTE_OK)
+        {
+            p->valid++;
+        }
+        else if (r == BYTE_FRAME_DONE)
+        {
+            uint16_t len = p->valid + 1U;
+            p->stats.frames++;
+            if (p->resyncing)
+            {
+                p->resyncing = 0;
+                p->stats.resyncBytes = p->sinceError;
+                if (p->sinceError > p->stats.maxResyncBytes)
+                    p->stats.maxResyncBytes = p->sinceError;
+            }
+            p->config->onFrame(p->buf, len);
+            FrameParser_Drop(p, len);
+        }
+        else
+        {
+            // Slide to the next start marker candidate already in the buffer
+            uint16_t skip = 1;
+            uint8_t start0 = (uint8_t)(p->config->startMarker & 0xFF);
+            while (skip < p->count && p->buf[skip] != start0)
+                skip++;
+
+            p->stats.errors++;
+            p->stats.discarded += skip;
+            if (!p->resyncing)
+            {
+                p->resyncing = 1;
+                p->sinceError = 0;
+            }
+            FrameParser_Drop(p, skip);
+        }
+    }
+}
+
+/* ==================== Public API ==================== */
+
+void FrameParser_Init(FrameParser *parser, const FrameParserConfig *config)
+{
+    memset(parser, 0, sizeof(*parser));
+    parser->config = config;
+}
+
+HOT_FUNC void FrameParser_PushByte(FrameParser *parser, uint8_t byte)
+{
+    parser->stats.bytes++;
+    if (parser->resyncing)
+        parser->sinceError++;
+
+    parser->buf[parser->count++] = byte;
+    FrameParser_Run(parser);
+}
+
+HOT_FUNC void FrameParser_Push(FrameParser *parser, const uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+        FrameParser_PushByte(parser, data[i]);
+}
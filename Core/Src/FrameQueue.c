@@ -0,0 +1,92 @@
+#include "FrameQueue.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#define FRAME_QUEUE_MASK (FRAME_QUEUE_DEPTH - 1U)
+
+_Static_assert((FRAME_QUEUE_DEPTH & FRAME_QUEUE_MASK) == 0, "FRAME_QUEUE_DEPTH must be a power of two");
+_Static_assert(FRAME_QUEUE_SLOT_SIZE <= UINT8_MAX, "frame length is stored in a uint8_t");
+
+typedef struct
+{
+    uint8_t len;
+    uint8_t data[FRAME_QUEUE_SLOT_SIZE];
+} FrameSlot;
+
+static FrameSlot slots[FRAME_QUEUE_DEPTH];
+
+// Free-running indexes, slot = index & FRAME_QUEUE_MASK
+static _Atomic uint32_t head; // written by the producer only
+static _Atomic uint32_t tail; // written by the consumer only
+
+// Written by the producer only
+static volatile uint32_t highWater;
+static volatile uint32_t overflows;
+static volatile uint32_t pushed;
+
+void FrameQueue_Init(void)
+{
+    atomic_store_explicit(&head, 0, memory_order_relaxed);
+    atomic_store_explicit(&tail, 0, memory_order_relaxed);
+    highWater = 0;
+    overflows = 0;
+    pushed = 0;
+}
+
+uint8_t FrameQueue_Push(const uint8_t *frame, uint8_t len)
+{
+    uint32_t h = atomic_load_explicit(&head, memory_order_relaxed);
+    // Acquire: the consumer is done reading the slot it released
+    uint32_t t = atomic_load_explicit(&tail, memory_order_acquire);
+
+    if (h - t >= FRAME_QUEUE_DEPTH || len > FRAME_QUEUE_SLOT_SIZE)
+    {
+        overflows++;
+        return 0;
+    }
+
+    FrameSlot *slot = &slots[h & FRAME_QUEUE_MASK];
+    memcpy(slot->data, frame, len);
+    slot->len = len;
+
+    // Release: slot contents are visible before the new head
+    atomic_store_explicit(&head, h + 1U, memory_order_release);
+
+    pushed++;
+    if (h + 1U - t > highWater)
+        highWater = h + 1U - t;
+    return 1;
+}
+
+const uint8_t *FrameQueue_Peek(uint8_t *len)
+{
+    uint32_t t = atomic_load_explicit(&tail, memory_order_relaxed);
+    // Acquire: pairs with the release in FrameQueue_Push
+    uint32_t h = atomic_load_explicit(&head, memory_order_acquire);
+
+    if (h == t)
+        return NULL;
+
+    const FrameSlot *slot = &slots[t & FRAME_QUEUE_MASK];
+    *len = slot->len;
+    return slot->data;
+}
+
+void FrameQueue_Release(void)
+{
+    uint32_t t = atomic_load_explicit(&tail, memory_order_relaxed);
+    if (t == atomic_load_explicit(&head, memory_order_acquire))
+        return;
+    atomic_store_explicit(&tail, t + 1U, memory_order_release);
+}
+
+void FrameQueue_GetStats(FrameQueueStats *stats)
+{
+    uint32_t t = atomic_load_explicit(&tail, memory_order_acquire);
+    uint32_t h = atomic_load_explicit(&head, memory_order_acquire);
+
+    stats->depth = h - t;
+    stats->highWater = highWater;
+    stats->overflows = overflows;
+    stats->pushed = pushed;
+}
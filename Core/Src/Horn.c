@@ -1,36 +1,143 @@
 #include "Horn.h"
+#include "SoftTimer.h"
+#include "Log.h"
 
-extern UART_HandleTypeDef huart1;
+typedef struct
+{
+    const uint16_t *steps; // ms, on / off alternating, starting with on
+    uint8_t count;
+    uint16_t repeatGapMs;  // off time between repetitions
+} HornSequence;
 
+#define MORSE_DOT  150U
+#define MORSE_DASH 450U
+#define MORSE_GAP  150U // between the signs of a letter
+#define MORSE_LETTER_GAP 450U
 
-void Horn_Init(void) {
-    HAL_GPIO_WritePin(HORN_GPIO_PORT, HORN_PIN, GPIO_PIN_RESET); // horn off
-    char msg[50];
-    snprintf(msg, sizeof(msg), "horn init\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), HAL_MAX_DELAY);
-    
+static const uint16_t continuousSteps[] = {1000}; // repeated without a gap
+static const uint16_t singleSteps[] = {300};
+static const uint16_t doubleSteps[] = {100, 100, 100};
+static const uint16_t sosSteps[] = {
+    MORSE_DOT, MORSE_GAP, MORSE_DOT, MORSE_GAP, MORSE_DOT, MORSE_LETTER_GAP,
+    MORSE_DASH, MORSE_GAP, MORSE_DASH, MORSE_GAP, MORSE_DASH, MORSE_LETTER_GAP,
+    MORSE_DOT, MORSE_GAP, MORSE_DOT, MORSE_GAP, MORSE_DOT,
+};
+
+#define SEQUENCE(steps, gap) {steps, sizeof(steps) / sizeof(steps[0]), gap}
+
+static const HornSequence sequences[HORN_PATTERN_COUNT] = {
+    [HORN_PATTERN_CONTINUOUS] = SEQUENCE(continuousSteps, 0),
+    [HORN_PATTERN_SINGLE] = SEQUENCE(singleSteps, 500),
+    [HORN_PATTERN_DOUBLE] = SEQUENCE(doubleSteps, 500),
+    [HORN_PATTERN_SOS] = SEQUENCE(sosSteps, 1050), // 7 dots between words
+};
+
+// Changed by the main loop with interrupts masked, stepped by the tick
+static const HornSequence *volatile playing = NULL;
+static uint8_t step;
+static uint32_t elapsedMs;
+static uint32_t durationMs;
+
+static inline void Horn_Write(uint8_t on)
+{
+    HAL_GPIO_WritePin(HORN_GPIO_PORT, HORN_PIN, on ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+// Apply the next step and time it; SoftTimer callback, runs in the tick
+static void Horn_Step(void *arg)
+{
+    (void)arg;
+    if (playing == NULL)
+        return;
+
+    uint32_t ms;
+    if (step < playing->count)
+    {
+        Horn_Write((step % 2U) == 0U);
+        ms = playing->steps[step++];
+    }
+    else if (elapsedMs < durationMs)
+    {
+        // Another repetition, after the gap if there is one
+        step = 0;
+        if (playing->repeatGapMs == 0)
+        {
+            Horn_Step(NULL);
+            return;
+        }
+        Horn_Write(0);
+        ms = playing->repeatGapMs;
+    }
+    else
+    {
+        Horn_Write(0);
+        playing = NULL;
+        return;
+    }
+
+    elapsedMs += ms;
+    SoftTimer_Start(SOFT_TIMER_HORN, ms, Horn_Step, NULL);
+}
+
+// Cancel the pattern, interrupts masked by the caller
+static void Horn_Cancel(void)
+{
+    playing = NULL;
+    SoftTimer_Stop(SOFT_TIMER_HORN);
 }
 
-void Horn_On(void) {
-        char msg[50];
-    snprintf(msg, sizeof(msg), "horn on\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), HAL_MAX_DELAY);
-    HAL_GPIO_WritePin(HORN_GPIO_PORT, HORN_PIN, GPIO_PIN_SET); // energize relay
+void Horn_Init(void)
+{
+    Horn_Cancel();
+    Horn_Write(0); // horn off
+    LOG(HORN_INIT);
 }
 
-void Horn_Off(void) {
-    char msg[50];
-    snprintf(msg, sizeof(msg), "horn off\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), HAL_MAX_DELAY);
-    HAL_GPIO_WritePin(HORN_GPIO_PORT, HORN_PIN, GPIO_PIN_RESET); // de-energize relay
+void Horn_On(void)
+{
+    LOG(HORN_ON);
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Horn_Cancel();
+    Horn_Write(1); // energize relay
+    __set_PRIMASK(primask);
 }
 
+void Horn_Off(void)
+{
+    LOG(HORN_OFF);
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Horn_Cancel();
+    Horn_Write(0); // de-energize relay
+    __set_PRIMASK(primask);
+}
+
+void Horn_Play(HornPattern pattern, uint32_t duration_ms)
+{
+    if (pattern >= HORN_PATTERN_COUNT)
+        return;
+
+    LOG(HORN_PATTERN, pattern, (int32_t)duration_ms);
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Horn_Cancel();
+    if (pattern == HORN_PATTERN_CONTINUOUS && duration_ms == 0)
+    {
+        Horn_Write(0);
+    }
+    else
+    {
+        playing = &sequences[pattern];
+        step = 0;
+        elapsedMs = 0;
+        durationMs = duration_ms;
+        Horn_Step(NULL);
+    }
+    __set_PRIMASK(primask);
+}
 
-void Horn_Toggle(uint32_t delay) {
-    HAL_GPIO_WritePin(HORN_GPIO_PORT, HORN_PIN, GPIO_PIN_SET); // energize relay
-    HAL_Delay(delay); // 100 ms honk
-    HAL_GPIO_WritePin(HORN_GPIO_PORT, HORN_PIN, GPIO_PIN_RESET); // de-energize relay
-    char msg[50];
-    snprintf(msg, sizeof(msg), "Horn toggle\r\n");
-    HAL_UART_Transmit(&huart1, (uint8_t*)msg, strlen(msg), HAL_MAX_DELAY);
+uint8_t Horn_IsPlaying(void)
+{
+    return playing != NULL;
 }
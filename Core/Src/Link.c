@@ -0,0 +1,165 @@
+#include "Link.h"
+#include "Packet.h"
+#include "UartTx.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LINK_MAX_GAP_NACKS 8 // MISSING reports per gap, the host times out the rest
+
+_Static_assert(LINK_WINDOW <= 32, "window is tracked in a 32-bit mask");
+
+static uint8_t started = 0;
+static uint8_t highestSeq;    // newest seq received
+static uint32_t receivedMask; // bit k set: seq (highestSeq - k) arrived intact
+static uint32_t executedMask; // bit k set: seq (highestSeq - k) ran
+static uint8_t txSeq = 0;     // seq of frames sent by the car
+
+void Link_Init(void)
+{
+    started = 0;
+    receivedMask = 0;
+    executedMask = 0;
+}
+
+// Distance of seq past the newest received one, negative for older seqs
+static inline int8_t Link_Ahead(uint8_t seq)
+{
+    return (int8_t)(seq - highestSeq);
+}
+
+// First frame, or a jump no window position covers: the host restarted its numbering
+static inline uint8_t Link_Restarted(int8_t ahead)
+{
+    return !started || ahead >= LINK_WINDOW || -ahead >= LINK_WINDOW;
+}
+
+void Link_Receive(uint8_t seq)
+{
+    int8_t ahead = Link_Ahead(seq);
+
+    if (Link_Restarted(ahead))
+    {
+        started = 1;
+        highestSeq = seq;
+        receivedMask = 1;
+        executedMask = 0;
+        return;
+    }
+
+    if (ahead > 0)
+    {
+        // Everything between the old and the new highest seq never arrived, its
+        // packet type is unknown. Keep one outbox slot for this frame's response
+        uint8_t nacks = 0;
+        for (uint8_t missing = highestSeq + 1;
+             missing != seq && nacks < LINK_MAX_GAP_NACKS && UartTx_Free() > 1;
+             missing++, nacks++)
+        {
+            Link_SendConfirmation(missing, PACKET_ID_NONE, CONFIRM_MISSING, NULL, 0);
+        }
+
+        receivedMask = (receivedMask << ahead) | 1U;
+        executedMask <<= ahead;
+        highestSeq = seq;
+        return;
+    }
+
+    // Retransmission filling an earlier gap
+    receivedMask |= 1UL << (uint8_t)(-ahead);
+}
+
+LinkVerdict Link_Check(uint8_t seq)
+{
+    int8_t ahead = Link_Ahead(seq);
+
+    if (Link_Restarted(ahead) || ahead > 0)
+        return LINK_NEW;
+    return (executedMask & (1UL << (uint8_t)(-ahead))) ? LINK_DUPLICATE : LINK_NEW;
+}
+
+void Link_Record(uint8_t seq)
+{
+    int8_t ahead = Link_Ahead(seq);
+
+    // Link_Receive has placed seq in the window
+    if (Link_Restarted(ahead) || ahead > 0)
+        return;
+    executedMask |= 1UL << (uint8_t)(-ahead);
+}
+
+void Link_SendConfirmation(uint8_t seq, uint8_t packetID, uint8_t status,
+                           const uint8_t *echo, uint8_t echoLen)
+{
+    uint8_t frame[PACKET_MAX_FRAME_SIZE];
+    uint8_t payload[PACKET_MAX_PAYLOAD] = {
+        LINK_CAR_ID,
+        packetID,
+        status,
+        seq};
+
+    if (echoLen > PACKET_MAX_PAYLOAD - CAR_CONFIRMATION_PAYLOAD_SIZE)
+        echoLen = PACKET_MAX_PAYLOAD - CAR_CONFIRMATION_PAYLOAD_SIZE;
+    if (echo != NULL)
+        memcpy(&payload[CAR_CONFIRMATION_PAYLOAD_SIZE], echo, echoLen);
+    else
+        echoLen = 0;
+
+    uint16_t len = PacketCodec_Encode(frame, txSeq++, CarConfirmation_ID, payload,
+                                      CAR_CONFIRMATION_PAYLOAD_SIZE + echoLen);
+    UartTx_Send(frame, len);
+}
+
+#if LINK_ASCII_REPLIES
+static void Link_SendText(const char *text)
+{
+    UartTx_Send((const uint8_t *)text, strlen(text));
+}
+
+static void Link_RespondAscii(const PacketView *packet, uint8_t status)
+{
+    switch (status)
+    {
+    case CONFIRM_ACK:
+        Link_SendText("Packet OK\r\n");
+        for (int i = 0; i < packet->len; i++)
+        {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "%02X\r\n", packet->payload[i]);
+            Link_SendText(buf);
+        }
+        break;
+    case 1:
+        Link_SendText("Invalid start or end packet values\r\n");
+        break;
+    case 2:
+        Link_SendText("Checksum mismatch\r\n");
+        break;
+    case 3:
+        Link_SendText("Unknown packet ID\r\n");
+        break;
+    case CONFIRM_DUPLICATE:
+        Link_SendText("Duplicate packet\r\n");
+        break;
+    default:
+        Link_SendText("Bad Packet\r\n");
+        break;
+    }
+}
+#endif
+
+void Link_Respond(const PacketView *packet, uint8_t status)
+{
+    if (packet != NULL)
+    {
+#if LINK_ECHO_PAYLOAD
+        if (status == CONFIRM_ACK)
+            Link_SendConfirmation(packet->seq, packet->packetID, status, packet->payload, packet->len);
+        else
+#endif
+            Link_SendConfirmation(packet->seq, packet->packetID, status, NULL, 0);
+    }
+
+#if LINK_ASCII_REPLIES
+    Link_RespondAscii(packet, status);
+#endif
+}
@@ -0,0 +1,133 @@
+#include "Log.h"
+
+#define LOG_RING_MASK    (LOG_RING_SIZE - 1U)
+#define LOG_HEADER_SIZE  6 // sync, site ID, tick
+
+_Static_assert((LOG_RING_SIZE & LOG_RING_MASK) == 0, "LOG_RING_SIZE must be a power of two");
+_Static_assert(LOG_SITE_COUNT <= UINT8_MAX, "site ID is sent as one byte");
+
+static const uint8_t siteArgs[LOG_SITE_COUNT] = {
+#define LOG_SITE(name, nargs, fmt) nargs,
+#include "LogSites.h"
+#undef LOG_SITE
+};
+
+// Argument counts must fit the LOG() macro
+#define LOG_SITE(name, nargs, fmt) _Static_assert(nargs <= LOG_MAX_ARGS, "too many arguments for " #name);
+#include "LogSites.h"
+#undef LOG_SITE
+
+static UART_HandleTypeDef *log_huart;
+static uint8_t ring[LOG_RING_SIZE];
+
+// Free-running indexes, changed with interrupts masked (writers may be ISRs)
+static volatile uint32_t head;     // next byte to write
+static volatile uint32_t tail;     // first byte not yet sent
+static volatile uint32_t inFlight; // bytes from tail on the wire, 0 when idle
+
+static volatile uint32_t written;
+static volatile uint32_t dropped;
+static volatile uint32_t highWater;
+
+static inline void Log_PutByte(uint32_t at, uint8_t value)
+{
+    ring[at & LOG_RING_MASK] = value;
+}
+
+static inline void Log_PutU32(uint32_t at, uint32_t value)
+{
+    Log_PutByte(at, (uint8_t)value);
+    Log_PutByte(at + 1U, (uint8_t)(value >> 8));
+    Log_PutByte(at + 2U, (uint8_t)(value >> 16));
+    Log_PutByte(at + 3U, (uint8_t)(value >> 24));
+}
+
+// Caller masks interrupts or runs in the ISR
+static void Log_StartNext(void)
+{
+    uint32_t t = tail;
+    uint32_t pending = head - t;
+
+    if (log_huart == NULL || inFlight != 0 || pending == 0)
+        return;
+
+    // One contiguous chunk, the rest follows on the next completion
+    uint32_t offset = t & LOG_RING_MASK;
+    uint32_t chunk = LOG_RING_SIZE - offset;
+    if (chunk > pending)
+        chunk = pending;
+
+    inFlight = chunk;
+    if (HAL_UART_Transmit_DMA(log_huart, &ring[offset], (uint16_t)chunk) != HAL_OK)
+        inFlight = 0; // retried on the next flush
+}
+
+/* ==================== Public API ==================== */
+
+void Log_Init(UART_HandleTypeDef *huart)
+{
+    log_huart = huart;
+    Log_Flush();
+}
+
+void Log_Write(LogSiteId id, const int32_t *args)
+{
+    uint8_t nargs = siteArgs[id];
+    uint32_t len = LOG_HEADER_SIZE + 4U * nargs;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t h = head;
+    uint32_t used = h - tail;
+    if (used + len > LOG_RING_SIZE)
+    {
+        dropped++;
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    Log_PutByte(h, LOG_SYNC);
+    Log_PutByte(h + 1U, (uint8_t)id);
+    Log_PutU32(h + 2U, HAL_GetTick());
+    for (uint8_t i = 0; i < nargs; i++)
+        Log_PutU32(h + LOG_HEADER_SIZE + 4U * i, (uint32_t)args[i]);
+
+    head = h + len;
+    written++;
+    if (used + len > highWater)
+        highWater = used + len;
+
+    __set_PRIMASK(primask);
+}
+
+void Log_Flush(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Log_StartNext();
+    __set_PRIMASK(primask);
+}
+
+void Log_OnTxCplt(void)
+{
+    tail += inFlight;
+    inFlight = 0;
+    Log_StartNext();
+}
+
+void Log_OnError(void)
+{
+    // Only a DMA error aborts the transfer, the chunk is lost
+    if (inFlight != 0 && log_huart->gState == HAL_UART_STATE_READY)
+    {
+        Log_OnTxCplt();
+    }
+}
+
+void Log_GetStats(LogStats *stats)
+{
+    stats->written = written;
+    stats->dropped = dropped;
+    stats->highWater = highWater;
+}
@@ -0,0 +1,109 @@
+#include "MotionProfile.h"
+#include <math.h>
+
+// Setpoint snaps onto the target once this close and this slow
+#define MOTION_SNAP_DISTANCE 0.5f
+
+static float MotionProfile_Clamp(float value, float limit)
+{
+    if (value > limit)
+        return limit;
+    if (value < -limit)
+        return -limit;
+    return value;
+}
+
+// Fastest speed from which the setpoint can still stop within distance
+static float MotionProfile_BrakingSpeed(const MotionLimits *limits, float distance)
+{
+    float a = limits->maxAccel;
+    if (limits->maxJerk <= 0.0f)
+        return sqrtf(2.0f * a * distance);
+
+    // Braking distance with jerk: v^2 / 2a + v a / 2j, solved for v
+    float j = limits->maxJerk;
+    float ramp = a * a / (2.0f * j);
+    return -ramp + sqrtf(ramp * ramp + 2.0f * a * distance);
+}
+
+void MotionProfile_Init(MotionProfile *profile, const MotionLimits *limits, float position)
+{
+    profile->limits = *limits;
+    MotionProfile_Reset(profile, position);
+}
+
+void MotionProfile_Reset(MotionProfile *profile, float position)
+{
+    profile->target = position;
+    profile->position = position;
+    profile->velocity = 0.0f;
+    profile->accel = 0.0f;
+    profile->done = 1;
+}
+
+void MotionProfile_SetTarget(MotionProfile *profile, float target)
+{
+    profile->target = target;
+    profile->done = 0;
+}
+
+void MotionProfile_SetLimits(MotionProfile *profile, const MotionLimits *limits)
+{
+    profile->limits = *limits;
+}
+
+float MotionProfile_Step(MotionProfile *profile, float dt)
+{
+    if (profile->done)
+        return profile->position;
+
+    const MotionLimits *limits = &profile->limits;
+    float remaining = profile->target - profile->position;
+    float maxStep = limits->maxAccel * dt;
+
+    if (fabsf(remaining) <= MOTION_SNAP_DISTANCE && fabsf(profile->velocity) <= maxStep)
+    {
+        MotionProfile_Reset(profile, profile->target);
+        return profile->position;
+    }
+
+    // Cruise at the velocity limit unless it is time to brake
+    float distance = fabsf(remaining);
+    float lead = 0.0f;
+    float towards = (remaining < 0.0f) ? -profile->accel : profile->accel;
+    if (limits->maxJerk > 0.0f && towards > 0.0f)
+    {
+        // Still accelerating towards the target: ramping that off takes
+        // accel/j seconds, covers distance and adds accel^2 / 2j of velocity
+        float j = limits->maxJerk;
+        float t = towards / j;
+        float speed = (remaining < 0.0f) ? -profile->velocity : profile->velocity;
+        distance -= speed * t + towards * towards * towards / (3.0f * j * j);
+        if (distance < 0.0f)
+            distance = 0.0f;
+        lead = towards * towards / (2.0f * j);
+    }
+    float desired = MotionProfile_BrakingSpeed(limits, distance) - lead;
+    if (desired > limits->maxVelocity)
+        desired = limits->maxVelocity;
+    if (remaining < 0.0f)
+        desired = -desired;
+
+    float change = desired - profile->velocity;
+    float accel = MotionProfile_Clamp(change / dt, limits->maxAccel);
+    if (limits->maxJerk > 0.0f)
+    {
+        // Ease off early: ramping accel to 0 still adds accel^2 / 2j of velocity
+        float easing = sqrtf(2.0f * limits->maxJerk * fabsf(change));
+        if (fabsf(accel) > easing)
+            accel = (change < 0.0f) ? -easing : easing;
+
+        float maxChange = limits->maxJerk * dt;
+        accel = profile->accel + MotionProfile_Clamp(accel - profile->accel, maxChange);
+    }
+
+    profile->accel = accel;
+    profile->velocity += accel * dt;
+    profile->position += profile->velocity * dt;
+    return profile->position;
+}
@@ -1,21 +1,17 @@
 #include "Motor_Angle.h"
-#include <stdio.h>
-#include <string.h>
+#include "Log.h"
+#include "CalibStore.h"
+#include "Speed_Motor.h"
+#include "Encoder.h"
+#include "PwmOut.h"
+#include "arm_math.h"
 #include <math.h>
-#include <inttypes.h>
-#include <stdarg.h>
 
 #include <stdlib.h> // for labs()
 
-extern TIM_HandleTypeDef htim3;   // Encoder timer (TIM3)
-extern TIM_HandleTypeDef htim4;   // PWM timer (TIM4)
-extern UART_HandleTypeDef huart1; // UART for debug messages
+extern TIM_HandleTypeDef htim4;   // PWM timer (TIM4), driven through PwmOut
 
-#define MOTOR_PWM_CHANNEL TIM_CHANNEL_1
-#define MOTOR_DIR_PORT GPIOB
-#define MOTOR_DIR_PIN GPIO_PIN_7
-
-#define ENCODER_COUNTS_PER_REV 1024 // Adjust per encoder spec
+#define ENCODER_COUNTS_PER_REV 2048 // x4 decoding, adjust per encoder spec
 #define ANGLE_TOLERANCE 2.0f        // Degrees tolerance
 
 // Direction flags
@@ -30,181 +26,450 @@ typedef struct
 } MotorCalibration;
 
 static MotorCalibration motor1_calib;
+static MotorCalibration storedCalib; // last one saved to flash, the frame homing refers to
 
 /* ==================== Encoder Functions ==================== */
-void Encoder_Init(TIM_HandleTypeDef *htim)
-{
-    HAL_TIM_Encoder_Start(&htim3, TIM_CHANNEL_ALL); // Start encoder mode
-    __HAL_TIM_SET_COUNTER(&htim3, 0);               // Reset to 0
-}
 
-void Motor_Print(const char *fmt, ...)
+// Steering position in counts (TIM3, x4, wrap-free); the range easily fits 32 bits
+static inline int32_t Motor_Angle_Position(void)
 {
-    char buffer[128]; // adjust size as needed
-    va_list args;
-    va_start(args, fmt);
-    vsnprintf(buffer, sizeof(buffer), fmt, args);
-    va_end(args);
-
-    HAL_UART_Transmit(&huart1, (uint8_t *)buffer, strlen(buffer), HAL_MAX_DELAY);
-    HAL_UART_Transmit(&huart1, "\r\n", 2, HAL_MAX_DELAY);
+    return (int32_t)Encoder_GetPosition(ENCODER_STEER);
 }
 
 /* ==================== Motor Helper Functions ==================== */
 
-void Motor_Angle_Stop(void)
+// Position loop state; pid and profile are owned by the control tick
+static arm_pid_instance_f32 steerPid;
+static MotionProfile steerProfile;         // setpoint trajectory towards steerTarget
+static volatile int32_t steerTarget;       // encoder count to hold
+static volatile uint8_t steerActive = 0;   // loop drives the motor
+static volatile uint8_t steerNewTarget = 0; // set by Motor_GotoEncoder, cleared by the tick
+static volatile uint8_t steerAtTarget = 0;
+static uint16_t steerTicks = 0;
+
+static MotionLimits steerLimits = {
+    .maxVelocity = STEER_PROFILE_MAX_VELOCITY,
+    .maxAccel = STEER_PROFILE_MAX_ACCEL,
+    .maxJerk = STEER_PROFILE_MAX_JERK,
+};
+static volatile uint8_t steerNewLimits = 0;
+
+// Calibration sweep, stepped by the control tick instead of the position loop
+typedef enum
 {
-    __HAL_TIM_SET_COMPARE(&htim4, MOTOR_PWM_CHANNEL, 0);
+    CALIB_IDLE = 0,
+    CALIB_SEEK_MIN,  // pulsing CCW until the left stop stalls the motor
+    CALIB_PAUSE_MIN,
+    CALIB_SEEK_MAX,  // pulsing CW until the right stop
+    CALIB_PAUSE_MAX,
+} CalibState;
+
+static volatile CalibState calibState = CALIB_IDLE;
+static volatile uint8_t steerCalibrated = 0;
+static volatile uint8_t calibSavePending = 0;
+static uint8_t calibHomeOnly;   // stored span valid, left stop only
+static volatile uint8_t steerTrusted = 0; // range taken from flash at boot, not checked against a stop yet
+static uint32_t calibMs;        // ms in the current state
+static uint16_t calibStepMs;    // ms into the current sweep step
+static int32_t calibOld;
+static uint16_t calibStill;     // consecutive samples without movement
+
+// Steering command received before calibration finished, run once it has
+static volatile uint8_t pendingGoto = 0;
+static volatile uint8_t pendingAngle;
+static volatile uint8_t pendingDirection;
+
+// Latest steering command, replayed after a re-home triggered by a stall
+static volatile uint8_t lastAngle = 0;
+static volatile uint8_t lastDirection = 0;
+
+// Saturated drive without movement, see STEER_STALL_REHOME_MS
+static int32_t stallPosition;
+static uint16_t stallMs;
+
+static void Motor_Angle_Drive(float duty)
+{
+    // Positive duty raises the count; calibration found encoder_max at the CW end (pin set)
+    uint8_t countUp = (duty >= 0.0f);
+    uint8_t cw = (motor1_calib.encoder_max >= motor1_calib.encoder_min) ? countUp : !countUp;
+
+    PwmOut_Set(PWM_OUT_STEER, cw ? fabsf(duty) : -fabsf(duty));
 }
 
-/**
- * Drive motor until encoder = target position (basic P control)
- */
+void Motor_Angle_Stop(void)
+{
+    steerActive = 0;
+    PwmOut_Stop(PWM_OUT_STEER);
+}
 
-void Motor_GotoEncoder(int32_t target, uint8_t direction)
+void Motor_GotoEncoder(int32_t target)
 {
-    int sm = 0;
-    while (1)
+    if (!steerCalibrated)
+        return;
+
+    int32_t lo = motor1_calib.encoder_min;
+    int32_t hi = motor1_calib.encoder_max;
+    if (lo > hi)
     {
-        int16_t raw = (int16_t)__HAL_TIM_GET_COUNTER(&htim3);
-        int16_t current = (int16_t)raw;
+        lo = motor1_calib.encoder_max;
+        hi = motor1_calib.encoder_min;
+    }
 
-        int32_t error = current - target;
+    if (target < lo || target > hi)
+    {
+        LOG(ANGLE_OUT_OF_RANGE, target, Motor_Angle_Position(), motor1_calib.encoder_max, motor1_calib.encoder_min);
+        target = (target < lo) ? lo : hi;
+    }
 
-        sm++;
-        if (sm % 10 == 0)
-        {
-            char msg[60];
-            snprintf(msg, sizeof(msg), "Target=%ld ,Current = %ld max : %d min :%d error : %d \r\n", target, current, motor1_calib.encoder_max, motor1_calib.encoder_min, error);
-            HAL_UART_Transmit(&huart1, (uint8_t *)msg, strlen(msg), HAL_MAX_DELAY);
-        }
-        // Stop condition
-        if (labs(error) <= 2) // tolerance = 10 counts
-        {
-            char msg[60];
-            snprintf(msg, sizeof(msg),
-                     "Errroror tolerance Target=%ld , Current = %ld\r\n",
-                     target, current);
+    steerTarget = target;
+    steerAtTarget = 0;
+    steerNewTarget = 1;
+    steerActive = 1;
+}
 
-            HAL_UART_Transmit(&huart1, (uint8_t *)msg, strlen(msg), HAL_MAX_DELAY);
+void Motor_Angle_Hold(void)
+{
+    pendingGoto = 0;
+    if (steerCalibrated && steerActive)
+        Motor_GotoEncoder(Motor_Angle_Position());
+}
 
-            __HAL_TIM_SET_COMPARE(&htim4, MOTOR_PWM_CHANNEL, 0); // stop PWM
+uint8_t Motor_Angle_AtTarget(void)
+{
+    return steerAtTarget;
+}
 
-            break;
-        }
+void Motor_Angle_SetProfileLimits(const MotionLimits *limits)
+{
+    if (limits->maxVelocity <= 0.0f || limits->maxAccel <= 0.0f || limits->maxJerk < 0.0f)
+        return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    steerLimits = *limits;
+    steerNewLimits = 1;
+    __set_PRIMASK(primask);
+}
 
-        if (target > motor1_calib.encoder_min || target < motor1_calib.encoder_max)
-        {
-            __HAL_TIM_SET_COMPARE(&htim4, MOTOR_PWM_CHANNEL, 0);
+/* ==================== Calibration ==================== */
 
-            char msg[60];
-            snprintf(msg, sizeof(msg), "Errroror Target=%d , max : %d min :%d Current = %ld\r\n", target, current, motor1_calib.encoder_max, motor1_calib.encoder_min);
-            HAL_UART_Transmit(&huart1, (uint8_t *)msg, strlen(msg), HAL_MAX_DELAY);
-            break;
-        }
+static void Motor_Angle_CalibStart(uint8_t homeOnly)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Motor_Angle_Stop();
+    steerCalibrated = 0;
+    calibHomeOnly = homeOnly;
+    steerTrusted = 0;
+    calibMs = 0;
+    calibStepMs = 0;
+    calibOld = -1;
+    calibStill = 0;
+    calibState = CALIB_SEEK_MIN;
+    __set_PRIMASK(primask);
+}
 
-        uint32_t arr = __HAL_TIM_GET_AUTORELOAD(&htim4);
+// One ms of the sweep: sample, pulse for STEER_CALIB_PULSE_MS, rest. 1 once stalled at the stop
+static uint8_t Motor_Angle_CalibSeek(void)
+{
+    if (calibStepMs == 0)
+    {
+        int32_t current = Motor_Angle_Position();
 
-        // Set motor direction
-        HAL_GPIO_WritePin(MOTOR_DIR_PORT, MOTOR_DIR_PIN, (direction == MOTOR_DIR_CW) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+        LOG(CALIB_RAW, current);
 
-        // Apply PWM (for now fixed at 60%, you can switch to pwmValue)
-        __HAL_TIM_SET_COMPARE(&htim4, MOTOR_PWM_CHANNEL, arr * 0.4f);
-        HAL_Delay(5);
-        Motor_Angle_Stop();
-        HAL_Delay(15);
+        if (abs(current - calibOld) <= STEER_CALIB_STILL_COUNTS)
+        {
+            if (++calibStill > STEER_CALIB_STALL_SAMPLES)
+            {
+                PwmOut_Stop(PWM_OUT_STEER);
+                return 1;
+            }
+        }
+        else
+        {
+            calibStill = 0;
+            calibOld = current;
+        }
+
+        // CCW (pin reset) towards the left stop, CW towards the right one
+        PwmOut_Set(PWM_OUT_STEER, (calibState == CALIB_SEEK_MIN) ? -STEER_CALIB_DUTY : STEER_CALIB_DUTY);
     }
+    else if (calibStepMs == STEER_CALIB_PULSE_MS)
+    {
+        PwmOut_Set(PWM_OUT_STEER, 0.0f);
+    }
+
+    if (++calibStepMs >= STEER_CALIB_PERIOD_MS)
+        calibStepMs = 0;
+    return 0;
 }
 
-/* ==================== Calibration ==================== */
+// Stored span moved by offset: same mechanics, only the counter origin differs
+static void Motor_Angle_ShiftStored(int32_t offset)
+{
+    motor1_calib.encoder_min = storedCalib.encoder_min + offset;
+    motor1_calib.encoder_max = storedCalib.encoder_max + offset;
+    motor1_calib.encoder_center = storedCalib.encoder_center + offset;
+}
 
-void Motor_Init_Angle(void)
+// Range known: accept steering commands
+static void Motor_Angle_Ready(void)
 {
-    uint32_t arr = __HAL_TIM_GET_AUTORELOAD(&htim4);
-    int32_t old, current;
-    int stableCounter;
+    LOG(CALIB_DONE,
+        motor1_calib.encoder_min,
+        motor1_calib.encoder_center,
+        motor1_calib.encoder_max);
+
+    calibState = CALIB_IDLE;
+    steerCalibrated = 1;
+    stallMs = 0;
+    MotionProfile_Reset(&steerProfile, (float)Motor_Angle_Position());
+
+    // A steering command that arrived while calibrating, otherwise back to center
+    if (pendingGoto)
+    {
+        pendingGoto = 0;
+        Motor_GotoAngle(pendingAngle, pendingDirection);
+    }
+    else
+    {
+        Motor_GotoAngle(0, 0);
+    }
+}
 
-    Motor_Print("arr %ld", arr);
-    HAL_TIM_PWM_Start(&htim4, MOTOR_PWM_CHANNEL);
-    Encoder_Init(&htim3);
+static void Motor_Angle_CalibFinish(void)
+{
+    if (calibHomeOnly)
+    {
+        Motor_Angle_ShiftStored(motor1_calib.encoder_min - storedCalib.encoder_min);
+    }
+    else
+    {
+        motor1_calib.encoder_center = (motor1_calib.encoder_min + motor1_calib.encoder_max) / 2;
+        storedCalib = motor1_calib;
+        calibSavePending = 1; // flash is written from the main loop once everything stands still
+    }
 
-    // ==== Move to LEFT limit ====
-    HAL_GPIO_WritePin(MOTOR_DIR_PORT, MOTOR_DIR_PIN, GPIO_PIN_RESET); // CCW
-    old = -1;
-    stableCounter = 0;
+    Motor_Angle_Ready();
+}
 
-    while (1)
+// Driven at full duty without moving: on a trusted range the stop is not where it should be
+static uint8_t Motor_Angle_Stalled(float duty, int32_t current)
+{
+    if (!steerTrusted || fabsf(duty) < STEER_MAX_DUTY ||
+        labs(current - stallPosition) > STEER_CALIB_STILL_COUNTS)
     {
-        int16_t raw = (int16_t)__HAL_TIM_GET_COUNTER(&htim3); // signed read
-        current = (int32_t)raw;
+        stallPosition = current;
+        stallMs = 0;
+        return 0;
+    }
+    return ++stallMs >= STEER_STALL_REHOME_MS;
+}
 
-        Motor_Print("raw=%d   current=%ld", raw, current);
+static void Motor_Angle_CalibTick(void)
+{
+    calibMs++;
 
-        if (abs(current - old) <= 10) // within 50 counts tolerance
-            stableCounter++;
-        else
+    switch (calibState)
+    {
+    case CALIB_SEEK_MIN:
+    case CALIB_SEEK_MAX:
+        if (Motor_Angle_CalibSeek())
+        {
+            int32_t stop = Motor_Angle_Position();
+            if (calibState == CALIB_SEEK_MIN)
+                motor1_calib.encoder_min = stop + 4;
+            else
+                motor1_calib.encoder_max = stop - 4;
+            calibState = (calibState == CALIB_SEEK_MIN) ? CALIB_PAUSE_MIN : CALIB_PAUSE_MAX;
+            calibMs = 0;
+        }
+        else if (calibMs >= STEER_CALIB_TIMEOUT_MS)
         {
-            stableCounter = 0;
-            old = current;
+            // Never stalled: no stop found, leave steering uncalibrated
+            PwmOut_Stop(PWM_OUT_STEER);
+            LOG(CALIB_FAILED, calibState, Motor_Angle_Position());
+            calibState = CALIB_IDLE;
+            pendingGoto = 0;
         }
+        break;
 
-        if (stableCounter > 50)
+    case CALIB_PAUSE_MIN:
+        if (calibMs < STEER_CALIB_PAUSE_MS)
             break;
+        if (calibHomeOnly)
+        {
+            Motor_Angle_CalibFinish();
+            break;
+        }
+        calibMs = 0;
+        calibStepMs = 0;
+        calibOld = -1;
+        calibStill = 0;
+        calibState = CALIB_SEEK_MAX;
+        break;
+
+    case CALIB_PAUSE_MAX:
+        if (calibMs >= STEER_CALIB_PAUSE_MS)
+            Motor_Angle_CalibFinish();
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* ==================== Position Loop ==================== */
 
-        __HAL_TIM_SET_COMPARE(&htim4, MOTOR_PWM_CHANNEL, arr * 0.9f); // 40% duty
-        HAL_Delay(10);
-        Motor_Angle_Stop();
-        HAL_Delay(20);
+void Motor_Angle_ControlTick(void)
+{
+    if (calibState != CALIB_IDLE)
+    {
+        Motor_Angle_CalibTick();
+        return;
     }
 
-    Motor_Angle_Stop();
-    motor1_calib.encoder_min = (int32_t)(int16_t)__HAL_TIM_GET_COUNTER(&htim3);
-    motor1_calib.encoder_min += 2;
+    int32_t current = Motor_Angle_Position();
 
-    HAL_Delay(500);
+    if (steerNewLimits)
+    {
+        steerNewLimits = 0;
+        MotionProfile_SetLimits(&steerProfile, &steerLimits);
+    }
+    if (steerNewTarget)
+    {
+        steerNewTarget = 0;
+        // Starting from rest: the trajectory begins where the motor actually is
+        if (steerProfile.done)
+        {
+            MotionProfile_Reset(&steerProfile, (float)current);
+            arm_pid_reset_f32(&steerPid);
+        }
+        MotionProfile_SetTarget(&steerProfile, (float)steerTarget);
+        steerTicks = 0;
+    }
+    if (!steerActive)
+    {
+        // Stopped mid-move: the next target starts a fresh trajectory
+        if (!steerProfile.done)
+            MotionProfile_Reset(&steerProfile, (float)current);
+        return;
+    }
 
-    // ==== Move to RIGHT limit ====
-    HAL_GPIO_WritePin(MOTOR_DIR_PORT, MOTOR_DIR_PIN, GPIO_PIN_SET); // CW
-    old = -1;
-    stableCounter = 0;
+    // The PID follows the profiled setpoint, not the final target
+    int32_t target = steerTarget;
+    float setpoint = MotionProfile_Step(&steerProfile, 1.0f / STEER_CONTROL_HZ);
+    int32_t error = (int32_t)lroundf(setpoint) - current;
 
-    while (1)
+    if (++steerTicks >= STEER_CONTROL_HZ / 10U)
     {
-        int16_t raw = (int16_t)__HAL_TIM_GET_COUNTER(&htim3);
-        current = (int32_t)raw;
+        steerTicks = 0;
+        LOG(ANGLE_TRACK, target, current, motor1_calib.encoder_max, motor1_calib.encoder_min, error);
+    }
 
-        if (abs(current - old) <= 10)
-            stableCounter++;
-        else
+    // Settled inside the deadband: hold without chattering and drop the integral
+    if (steerProfile.done && labs(error) <= STEER_DEADBAND_COUNTS)
+    {
+        if (!steerAtTarget)
         {
-            stableCounter = 0;
-            old = current;
+            steerAtTarget = 1;
+            LOG(ANGLE_REACHED, target, current);
         }
+        arm_pid_reset_f32(&steerPid);
+        PwmOut_Set(PWM_OUT_STEER, 0.0f);
+        return;
+    }
+    steerAtTarget = 0;
 
-        if (stableCounter > 50)
-            break;
+    float duty = arm_pid_f32(&steerPid, setpoint - (float)current);
+    if (duty > STEER_MAX_DUTY)
+        duty = STEER_MAX_DUTY;
+    else if (duty < -STEER_MAX_DUTY)
+        duty = -STEER_MAX_DUTY;
+    // Anti-windup: the next step starts from the output actually applied
+    steerPid.state[2] = duty;
 
-        __HAL_TIM_SET_COMPARE(&htim4, MOTOR_PWM_CHANNEL, arr * 0.9f);
-        HAL_Delay(10);
-        Motor_Angle_Stop();
-        HAL_Delay(20);
+    if (Motor_Angle_Stalled(duty, current))
+    {
+        LOG(STEER_STALL_REHOME, current, target);
+        Motor_Angle_Rehome();
+        pendingAngle = lastAngle;
+        pendingDirection = lastDirection;
+        pendingGoto = 1;
+        return;
     }
 
+    Motor_Angle_Drive(duty);
+}
+
+/* ==================== Calibration ==================== */
+
+void Motor_Init_Angle(void)
+{
+    LOG(CALIB_ARR, (int32_t)__HAL_TIM_GET_AUTORELOAD(&htim4));
+
     Motor_Angle_Stop();
-    motor1_calib.encoder_max = (int32_t)(int16_t)__HAL_TIM_GET_COUNTER(&htim3);
-    motor1_calib.encoder_max -= 2;
+    steerPid.Kp = STEER_KP;
+    steerPid.Ki = STEER_KI;
+    steerPid.Kd = STEER_KD;
+    arm_pid_init_f32(&steerPid, 1);
+    MotionProfile_Init(&steerProfile, &steerLimits, 0.0f);
 
-    HAL_Delay(500);
+    if (CalibStore_Load(STEER_CALIB_VERSION, &storedCalib, sizeof(storedCalib)))
+    {
+        LOG(CALIB_LOADED, storedCalib.encoder_min, storedCalib.encoder_center, storedCalib.encoder_max);
+#if STEER_BOOT_REHOME
+        // Re-reference the counter against the left stop before steering
+        Motor_Angle_CalibStart(1);
+#else
+        // Trust the record with the steering where it was left, at center;
+        // Motor_Angle_Stalled re-homes if that turns out wrong
+        Motor_Angle_ShiftStored(Motor_Angle_Position() - storedCalib.encoder_center);
+        Motor_Angle_Ready();
+        steerTrusted = 1;
+#endif
+    }
+    else
+    {
+        Motor_Angle_CalibStart(0);
+    }
+}
 
-    // ==== Compute center ====
-    motor1_calib.encoder_center = (motor1_calib.encoder_min + motor1_calib.encoder_max) / 2;
+void Motor_Angle_Recalibrate(void)
+{
+    Motor_Angle_CalibStart(0);
+}
+
+void Motor_Angle_Rehome(void)
+{
+    // Calibrated means storedCalib holds the span, only the left stop is needed
+    Motor_Angle_CalibStart(steerCalibrated);
+}
 
-    Motor_Print("min=%ld   mid=%ld   max=%ld",
-                motor1_calib.encoder_min,
-                motor1_calib.encoder_center,
-                motor1_calib.encoder_max);
+uint8_t Motor_Angle_IsCalibrated(void)
+{
+    return steerCalibrated;
+}
 
-    Motor_GotoAngle(0, 0);
+void Motor_Angle_Process(void)
+{
+    if (!calibSavePending)
+        return;
+
+    // Flash stalls every flash-resident ISR (control tick, deadman) while it
+    // is programmed: wait until nothing moves, the save stays pending till then
+    if (calibState != CALIB_IDLE || !Motor_Angle_AtTarget() || !Motor_IsStopped())
+        return;
+
+    MotorCalibration calib;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    calib = storedCalib;
+    calibSavePending = 0;
+    __set_PRIMASK(primask);
+
+    LOG(CALIB_SAVED, CalibStore_Save(STEER_CALIB_VERSION, &calib, sizeof(calib)));
 }
 
 /* ================Motor_GotoAngle==== User API ==================== */
@@ -220,6 +485,21 @@ void Motor_GotoAngle(uint8_t angle_deg, uint8_t direction)
     if (angle_deg > 90)
         angle_deg = 90;
 
+    // No range to map the angle to yet, keep the latest request for later
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    lastAngle = angle_deg;
+    lastDirection = direction;
+    if (!steerCalibrated)
+    {
+        pendingAngle = angle_deg;
+        pendingDirection = direction;
+        pendingGoto = 1;
+        __set_PRIMASK(primask);
+        return;
+    }
+    __set_PRIMASK(primask);
+
     int32_t halfRange = (motor1_calib.encoder_max - motor1_calib.encoder_min) / 2;
     int32_t target;
 
@@ -232,14 +512,12 @@ void Motor_GotoAngle(uint8_t angle_deg, uint8_t direction)
         target = motor1_calib.encoder_center + ((int32_t)angle_deg * halfRange) / 90;
     }
 
-    int16_t raw = (int16_t)__HAL_TIM_GET_COUNTER(&htim3);
-    int32_t cnt = (int32_t)raw;
+    int32_t cnt = Motor_Angle_Position();
 
-    char msg[60];
-    snprintf(msg, sizeof(msg), "Angle sent =%ld  Target=%ld  Current=%ld\r\n", angle_deg, target, cnt);
-    HAL_UART_Transmit(&huart1, (uint8_t *)msg, strlen(msg), HAL_MAX_DELAY);
+    LOG(ANGLE_CMD, angle_deg, target, cnt);
 
-    Motor_GotoEncoder(target, direction);
+    // Returns at once, the control tick moves the motor
+    Motor_GotoEncoder(target);
 }
 
 // void Encoder_ReadData(TIM_HandleTypeDef *htim, uint8_t motorID)
@@ -1,233 +1,414 @@
 #include "Packet.h"
 #include "CheckSum.h"
-#include "uart.h"
+#include "Log.h"
 #include "Motor_Angle.h"
 #include "Speed_Motor.h"
 #include "Horn.h"
 #include "Light.h"
-#include <stdio.h>
-#include <string.h>
+#include "PwmOut.h"
+#include "CycleCounter.h"
 
-// Assuming these are declared elsewhere
-extern TIM_HandleTypeDef htim3;
-extern UART_HandleTypeDef huart1;
+uint16_t FillData(const uint8_t *payload, uint8_t len, PacketID packetID)
+{
+    uint8_t frame[PACKET_MAX_FRAME_SIZE];
+
+    if (PacketCodec_Encode(frame, 0, (uint8_t)packetID, payload, len) == 0)
+        return 0; // longer than PACKET_MAX_PAYLOAD
+
+    return PacketCodec_GetU16(frame + PACKET_OFFSET_PAYLOAD + len);
+}
+uint16_t FillData_MotorAngle(uint8_t id, int16_t angle, uint8_t direction)
+{
+    uint8_t payload[MOTOR_ANGLE_PAYLOAD_SIZE];
+    payload[0] = id;
+    PacketCodec_PutU16(&payload[1], (uint16_t)angle);
+    payload[3] = direction;
+
+    return FillData(payload, sizeof(payload), MotorAngle_ID);
+}
+
+/* ==================== Dispatch Table ==================== */
+
+// Payload decoded into the struct of its packet type
+typedef union
+{
+    struct Motor motor;
+    struct MotorAngle motorAngle;
+    struct CarHorn carHorn;
+    struct CarLight carLight;
+    struct CarConfirmation carConfirmation;
+    struct MotorRpm motorRpm;
+    struct MotorTimed motorTimed;
+    struct MotorCalibrate motorCalibrate;
+    struct PwmMode pwmMode;
+} PacketCommand;
+
+// Accepted range of one payload field, checked on the raw bytes before decoding
+typedef struct
+{
+    uint8_t offset;    // byte offset in the payload
+    uint8_t isI16;     // 1: little-endian int16, 0: uint8
+    int16_t min;
+    int16_t max;
+    uint8_t error;     // SerializePacket result when out of range
+} PacketFieldRange;
 
-uint16_t FillData(const uint8_t payload[PAYLOAD_SIZE], PacketID packetID)
+typedef struct
 {
-    struct Packet packet;
-    packet.start_packet = 0xAA55;
-    packet.end_packet = 0x0D0A;
-    packet.count = 1;
-    packet.packetID = (uint8_t)packetID;
+    uint8_t payloadSize;
+    void (*decode)(const uint8_t *payload, PacketCommand *cmd);
+    const PacketFieldRange *ranges;
+    uint8_t rangeCount;
+    void (*handle)(const PacketCommand *cmd); // runs only after every range passed
+} PacketHandler;
 
-    memcpy(packet.payload, payload, PAYLOAD_SIZE);
+#define PACKET_ID_COUNT (PwmMode_ID + 1) // highest packet ID + 1
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
 
-    uint8_t checksumData[6];
-    memcpy(checksumData, packet.payload, PAYLOAD_SIZE);
-    checksumData[4] = (uint8_t)packetID;
-    checksumData[5] = packet.count;
+/* ---------- Motor ---------- */
 
-    packet.checksum = checksum(checksumData, sizeof(checksumData));
+static const PacketFieldRange motorRanges[] = {
+    {0, 0, 1, 3, 5},   // motor ID
+    {1, 0, 0, 100, 6}, // speed
+    {2, 0, 0, 1, 7},   // direction
+};
 
-    return packet.checksum;
+static void Motor_Decode(const uint8_t *payload, PacketCommand *cmd)
+{
+    cmd->motor.ID = payload[0];
+    cmd->motor.speed = payload[1];
+    cmd->motor.direction = payload[2];
 }
-uint16_t FillData_MotorAngle(uint8_t id, int16_t angle, uint8_t direction)
+
+static void Motor_Handle(const PacketCommand *cmd)
+{
+    Motor_SetSpeed(cmd->motor.ID, cmd->motor.speed, cmd->motor.direction);
+}
+
+/* ---------- Motor Timed ---------- */
+
+// Same ID/speed/direction checks as the Motor packet, any duration
+static void MotorTimed_Decode(const uint8_t *payload, PacketCommand *cmd)
 {
-    struct Packet packet;
-    packet.start_packet = 0xAA55;
-    packet.end_packet = 0x0D0A;
-    packet.count = 1;
-    packet.packetID = MotorAngle_ID;
+    cmd->motorTimed.ID = payload[0];
+    cmd->motorTimed.speed = payload[1];
+    cmd->motorTimed.direction = payload[2];
+    cmd->motorTimed.duration = PacketCodec_GetU16(&payload[3]);
+}
 
-    packet.payload[0] = id;
-    packet.payload[1] = (uint8_t)(angle & 0xFF);
-    packet.payload[2] = (uint8_t)((angle >> 8) & 0xFF);
-    packet.payload[3] = direction;
+static void MotorTimed_Handle(const PacketCommand *cmd)
+{
+    Motor_Drive(cmd->motorTimed.ID, cmd->motorTimed.speed, cmd->motorTimed.direction, cmd->motorTimed.duration);
+}
 
-    uint8_t checksumData[6];
-    memcpy(checksumData, packet.payload, PAYLOAD_SIZE);
-    checksumData[4] = packet.packetID;
-    checksumData[5] = packet.count;
+/* ---------- Motor RPM ---------- */
 
-    packet.checksum = checksum(checksumData, sizeof(checksumData));
+static const PacketFieldRange motorRpmRanges[] = {
+    {0, 0, 1, 3, 5},                                             // motor ID
+    {1, 1, -(int16_t)WHEEL_MAX_RPM, (int16_t)WHEEL_MAX_RPM, 6}, // rpm
+};
 
-    return packet.checksum;
+static void MotorRpm_Decode(const uint8_t *payload, PacketCommand *cmd)
+{
+    cmd->motorRpm.ID = payload[0];
+    cmd->motorRpm.rpm = PacketCodec_GetI16(&payload[1]);
 }
 
-uint8_t SerializePacket(const struct Packet *packet)
+static void MotorRpm_Handle(const PacketCommand *cmd)
 {
-    if (!packet)
-        return 4; // Null pointer
+    Motor_SetRpm(cmd->motorRpm.ID, cmd->motorRpm.rpm);
+}
 
-    // Validate start/end markers
-    if (packet->start_packet != 0xAA55 || packet->end_packet != 0x0D0A)
-    {
-        HAL_UART_Transmit(&huart1, (const uint8_t *)"Invalid start or end packet values.\r\n", 36, HAL_MAX_DELAY);
-        return 1;
-    }
+/* ---------- Motor Angle ---------- */
 
-    // Validate checksum
-    uint8_t checksumData[6];
-    memcpy(checksumData, packet->payload, PAYLOAD_SIZE);
-    checksumData[4] = packet->packetID;
-    checksumData[5] = packet->count;
+static const PacketFieldRange motorAngleRanges[] = {
+    {1, 1, 0, 90, 4}, // angle
+};
 
-    uint16_t checksumResult = checksum(checksumData, 6);
-    if (packet->checksum != checksumResult)
-    {
-        return 2; // Checksum mismatch
-    }
+static void MotorAngle_Decode(const uint8_t *payload, PacketCommand *cmd)
+{
+    cmd->motorAngle.ID = payload[0];
+    cmd->motorAngle.angle = PacketCodec_GetI16(&payload[1]);
+    cmd->motorAngle.direction = payload[3];
+}
 
-    // Process packet by ID
-    switch (packet->packetID)
-    {
-    case Motor_ID:
-    {
-        struct Motor motor = {
-            .ID = packet->payload[0],
-            .speed = packet->payload[1],
-            .direction = packet->payload[2]};
+static void MotorAngle_Handle(const PacketCommand *cmd)
+{
+    const struct MotorAngle *motorAngle = &cmd->motorAngle;
 
-        if (motor.ID < 1 || motor.ID > 3)
-        {
-            HAL_UART_Transmit(&huart1, (const uint8_t *)"Invalid motor ID.\r\n", 20, HAL_MAX_DELAY);
-            return 5; // Invalid motor ID
-        }
-        if (motor.speed > 100 || motor.speed < 0)
-        {
-            HAL_UART_Transmit(&huart1, (const uint8_t *)"Invalid speed value.\r\n", 23, HAL_MAX_DELAY);
-            return 6; // Invalid speed
-        }
-        if (motor.direction > 1 || motor.direction < 0)
-        {
-            HAL_UART_Transmit(&huart1, (const uint8_t *)"Invalid direction value.\r\n", 26, HAL_MAX_DELAY);
-            return 7; // Invalid direction
-        }
-        // Run motor 1 forward at 60%
+    LOG(PACKET_MOTOR_ANGLE, motorAngle->ID, motorAngle->angle, motorAngle->direction);
 
-        Motor_SetSpeed(motor.ID, motor.speed, motor.direction);
+    Motor_GotoAngle(motorAngle->angle, motorAngle->direction);
+}
 
-        break;
-    }
+/* ---------- Steering Calibration ---------- */
 
-    case MotorAngle_ID:
-    {
-        struct MotorAngle motorAngle;
-        motorAngle.ID = packet->payload[0];
-        motorAngle.angle = (int16_t)(packet->payload[1] | (packet->payload[2] << 8));
-        motorAngle.direction = packet->payload[3];
-        if (motorAngle.angle > 90 || motorAngle.angle < 0)
-        {
-            HAL_UART_Transmit(&huart1, (const uint8_t *)"Invalid angle value.\r\n", sizeof("Invalid angle value.\r\n"), HAL_MAX_DELAY);
-            return 4; // Invalid angle
-        }
+static const PacketFieldRange motorCalibrateRanges[] = {
+    {0, 0, 1, 1, 5}, // motor ID
+};
+
+static void MotorCalibrate_Decode(const uint8_t *payload, PacketCommand *cmd)
+{
+    cmd->motorCalibrate.ID = payload[0];
+}
 
-        HAL_UART_Transmit(&huart1, (uint8_t *)"Encoder Data Read in Packet:\r\n", sizeof("Encoder Data Read in Packet:\r\n"), HAL_MAX_DELAY);
-        char angle_msg[64];
-        snprintf(angle_msg, sizeof(angle_msg),
-                 "sended M%02X: Target=%04X, Current=%04X\r\n",
-                 motorAngle.ID, motorAngle.angle, motorAngle.direction);
-        HAL_UART_Transmit(&huart1, (uint8_t *)angle_msg, strlen(angle_msg), HAL_MAX_DELAY);
-        
-        Motor_GotoAngle(motorAngle.angle, motorAngle.direction);
-        break;
+static void MotorCalibrate_Handle(const PacketCommand *cmd)
+{
+    (void)cmd;
+    Motor_Angle_Recalibrate();
+}
+
+/* ---------- Horn ---------- */
+
+static const PacketFieldRange carHornRanges[] = {
+    {2, 0, 0, HORN_PATTERN_COUNT - 1, 11}, // pattern
+};
+
+static void CarHorn_Decode(const uint8_t *payload, PacketCommand *cmd)
+{
+    cmd->carHorn.ID = payload[0];
+    cmd->carHorn.duartion = payload[1];
+    cmd->carHorn.pattern = payload[2];
+}
+
+static void CarHorn_Handle(const PacketCommand *cmd)
+{
+    // Returns at once, the soft timer plays the pattern
+    Horn_Play((HornPattern)cmd->carHorn.pattern, (uint32_t)cmd->carHorn.duartion * 1000U);
+}
+
+/* ---------- Light ---------- */
+
+// Indexed by lightStatus
+static void (*const lightActions[])(void) = {
+    Light_Front_Off,
+    Light_Front_On,
+    Light_Back_On,
+    Light_Back_Off,
+    Light_Right_On,
+    Light_Right_Off,
+    Light_Left_On,
+    Light_Left_Off,
+};
+
+static const PacketFieldRange carLightRanges[] = {
+    {1, 0, 0, COUNT_OF(lightActions) - 1, 8}, // lightStatus
+};
+
+static void CarLight_Decode(const uint8_t *payload, PacketCommand *cmd)
+{
+    cmd->carLight.ID = payload[0];
+    cmd->carLight.lightStatus = payload[1];
+}
+
+static void CarLight_Handle(const PacketCommand *cmd)
+{
+    lightActions[cmd->carLight.lightStatus]();
+}
+
+/* ---------- Confirmation ---------- */
+
+static void CarConfirmation_Decode(const uint8_t *payload, PacketCommand *cmd)
+{
+    cmd->carConfirmation.ID = payload[0];
+    cmd->carConfirmation.packetID = payload[1];
+    cmd->carConfirmation.confirmationStatus = payload[2];
+    cmd->carConfirmation.value = payload[3];
+}
+
+static void CarConfirmation_Handle(const PacketCommand *cmd)
+{
+    // Confirmations from the host need no action
+    (void)cmd;
+}
+
+/* ---------- Heartbeat ---------- */
+
+static void Heartbeat_Decode(const uint8_t *payload, PacketCommand *cmd)
+{
+    (void)payload;
+    (void)cmd;
+}
+
+static void Heartbeat_Handle(const PacketCommand *cmd)
+{
+    // The deadman is fed for every intact frame, nothing else to do
+    (void)cmd;
+}
+
+/* ---------- PWM Mode ---------- */
+
+static const PacketFieldRange pwmModeRanges[] = {
+    {0, 0, 1, 1, 5},  // ID
+    {1, 0, 0, 1, 12}, // inaudible
+};
+
+static void PwmMode_Decode(const uint8_t *payload, PacketCommand *cmd)
+{
+    cmd->pwmMode.ID = payload[0];
+    cmd->pwmMode.inaudible = payload[1];
+}
+
+static void PwmMode_Handle(const PacketCommand *cmd)
+{
+    // Running duties carry over, the new carrier starts on the next update event
+    PwmOut_SetInaudible(cmd->pwmMode.inaudible);
+}
+
+/* ---------- Table ---------- */
+
+// New packet types are registered here; IDs without a handler are unknown
+static const PacketHandler packetTable[PACKET_ID_COUNT] = {
+    [Motor_ID] = {MOTOR_PAYLOAD_SIZE, Motor_Decode, motorRanges, COUNT_OF(motorRanges), Motor_Handle},
+    [MotorAngle_ID] = {MOTOR_ANGLE_PAYLOAD_SIZE, MotorAngle_Decode, motorAngleRanges, COUNT_OF(motorAngleRanges), MotorAngle_Handle},
+    [CarHorn_ID] = {CAR_HORN_PAYLOAD_SIZE, CarHorn_Decode, carHornRanges, COUNT_OF(carHornRanges), CarHorn_Handle},
+    [CarLight_ID] = {CAR_LIGHT_PAYLOAD_SIZE, CarLight_Decode, carLightRanges, COUNT_OF(carLightRanges), CarLight_Handle},
+    [CarConfirmation_ID] = {CAR_CONFIRMATION_PAYLOAD_SIZE, CarConfirmation_Decode, NULL, 0, CarConfirmation_Handle},
+    [MotorRpm_ID] = {MOTOR_RPM_PAYLOAD_SIZE, MotorRpm_Decode, motorRpmRanges, COUNT_OF(motorRpmRanges), MotorRpm_Handle},
+    [MotorTimed_ID] = {MOTOR_TIMED_PAYLOAD_SIZE, MotorTimed_Decode, motorRanges, COUNT_OF(motorRanges), MotorTimed_Handle},
+    [MotorCalibrate_ID] = {MOTOR_CALIBRATE_PAYLOAD_SIZE, MotorCalibrate_Decode, motorCalibrateRanges, COUNT_OF(motorCalibrateRanges), MotorCalibrate_Handle},
+    [Heartbeat_ID] = {HEARTBEAT_PAYLOAD_SIZE, Heartbeat_Decode, NULL, 0, Heartbeat_Handle},
+    [PwmMode_ID] = {PWM_MODE_PAYLOAD_SIZE, PwmMode_Decode, pwmModeRanges, COUNT_OF(pwmModeRanges), PwmMode_Handle},
+};
+
+static PacketDispatchStats dispatchStats;
+
+static const PacketHandler *Packet_Lookup(uint8_t packetID)
+{
+    if (packetID >= PACKET_ID_COUNT || packetTable[packetID].handle == NULL)
+        return NULL;
+    return &packetTable[packetID];
+}
+
+uint8_t Packet_PayloadSize(uint8_t packetID)
+{
+    const PacketHandler *handler = Packet_Lookup(packetID);
+    return handler ? handler->payloadSize : 0;
+}
+
+/* ==================== Validation ==================== */
+
+// Range checks only, nothing is actuated here
+static uint8_t Packet_Validate(uint8_t packetID, const PacketHandler *handler, const uint8_t *payload, uint8_t len)
+{
+    if (handler == NULL)
+    {
+        LOG(PACKET_UNKNOWN_ID, packetID);
+        return 3;
+    }
+    if (len != handler->payloadSize)
+    {
+        LOG(PACKET_BAD_LENGTH, packetID, len);
+        return 9; // Payload length does not match packet ID
     }
 
-    case CarHorn_ID:
+    for (uint8_t i = 0; i < handler->rangeCount; i++)
     {
-        struct CarHorn carHorn = {
-            .ID = packet->payload[0],
-            .duartion = packet->payload[1]};
+        const PacketFieldRange *range = &handler->ranges[i];
+        int16_t value = range->isI16 ? PacketCodec_GetI16(&payload[range->offset])
+                                     : payload[range->offset];
 
-        if (carHorn.duartion < 0)
-        {
-            HAL_UART_Transmit(&huart1, (const uint8_t *)"Invalid duration.\r\n", sizeof("Invalid duration.\r\n"), HAL_MAX_DELAY);
-            return 5; // Invalid angle
-        }
-        else
+        if (value < range->min || value > range->max)
         {
-            Horn_Toggle((carHorn.duartion) * 1000);
+            LOG(PACKET_BAD_FIELD, packetID, range->error, value);
+            return range->error;
         }
-        break;
     }
 
-    case CarLight_ID:
-    {
-        struct CarLight carLight = {
-            .ID = packet->payload[0],
-            .lightStatus = packet->payload[1]};
+    return 0;
+}
 
-        if (carLight.lightStatus > 8)
-        {
+/* ==================== Actuation ==================== */
 
-            char msg[50];
-            snprintf(msg, sizeof(msg), "Invaild ID %02X\r\n", carLight.lightStatus);
-            HAL_UART_Transmit(&huart1, (uint8_t *)msg, strlen(msg), HAL_MAX_DELAY);
-            // HAL_UART_Transmit(&huart1, (const uint8_t *)"Invalid light status value.\r\n", 30, HAL_MAX_DELAY);
-            return 8; // Invalid light status
-        }
+// Payload must have passed Packet_Validate
+static void Packet_Apply(const PacketHandler *handler, const uint8_t *payload)
+{
+    PacketCommand cmd;
+    handler->decode(payload, &cmd);
+    handler->handle(&cmd);
+}
 
-        if (carLight.lightStatus == 0)
-        {
-            // front off
-            Light_Front_Off();
-        }
-        else if (carLight.lightStatus == 1)
-        {
-            // front on
-            Light_Front_On();
-        }
+/* ==================== Batch ==================== */
 
-        else if (carLight.lightStatus == 2)
-        {
-            // back on
-            Light_Back_On();
-        }
-        else if (carLight.lightStatus == 3)
-        {
-            // back off
-            Light_Back_Off();
-        }
-        else if (carLight.lightStatus == 4)
-        {
-            // rigth on
-            Light_Right_On();
-        }
-        else if (carLight.lightStatus == 5)
-        {
-            // right off
-            Light_Right_Off();
-        }
-        else if (carLight.lightStatus == 6)
-        {
-            // left on
-            Light_Left_On();
-        }
-        else if (carLight.lightStatus == 7)
-        {
-            // left off
-            Light_Left_Off();
-        }
+/*
+ * Batch payload: count, then count records of [packetID][payload].
+ * Every record is validated before any is applied, so a bad record
+ * rejects the whole batch and the rest are applied in one pass.
+ */
+static uint8_t Packet_ProcessBatch(const PacketView *packet)
+{
+    const uint8_t *records[BATCH_MAX_COMMANDS];
+    uint8_t offset = 1;
 
-        break;
-    }
+    if (packet->len < 1)
+        return 9; // Missing count
 
-    case CarConfirmation_ID:
-    {
-        struct CarConfirmation carConfirmation = {
-            .ID = packet->payload[0],
-            .confirmationStatus = packet->payload[1],
-            .value = packet->payload[2]};
-        break;
-    }
-    default:
+    uint8_t count = packet->payload[0];
+    if (count == 0 || count > BATCH_MAX_COMMANDS)
+        return 10; // Invalid batch count
+
+    for (uint8_t i = 0; i < count; i++)
     {
-        HAL_UART_Transmit(&huart1,
-                          (const uint8_t *)"Unknown packet ID\r\n",
-                          19, HAL_MAX_DELAY);
-        return 3;
-    }
+        if (offset >= packet->len)
+            return 9; // Fewer records than count
+
+        uint8_t subID = packet->payload[offset];
+        const PacketHandler *handler = Packet_Lookup(subID);
+        if (handler == NULL)
+            return 3; // Unknown or nested packet ID
+        uint8_t size = handler->payloadSize;
+        if (offset + 1U + size > packet->len)
+            return 9; // Record runs past the payload
+
+        uint8_t result = Packet_Validate(subID, handler, &packet->payload[offset + 1], size);
+        if (result != 0)
+            return result;
+
+        records[i] = &packet->payload[offset];
+        offset += 1U + size;
     }
 
+    if (offset != packet->len)
+        return 9; // Trailing bytes after the last record
+
+    for (uint8_t i = 0; i < count; i++)
+        Packet_Apply(Packet_Lookup(records[i][0]), &records[i][1]);
+
+    return 0;
+}
+
+uint8_t SerializePacket(const PacketView *packet)
+{
+    if (!packet)
+        return 4; // Null pointer
+
+    // Markers and checksum were checked by PacketCodec_Decode
+    if (packet->packetID == CarBatch_ID)
+        return Packet_ProcessBatch(packet);
+
+    uint32_t start = CycleCounter_Now();
+
+    const PacketHandler *handler = Packet_Lookup(packet->packetID);
+    uint8_t result = Packet_Validate(packet->packetID, handler, packet->payload, packet->len);
+    if (result != 0)
+        return result;
+
+    PacketCommand cmd;
+    handler->decode(packet->payload, &cmd);
+
+    // Dispatch cost only, the handler itself may block
+    uint32_t cycles = CycleCounter_Now() - start;
+    dispatchStats.dispatched++;
+    dispatchStats.lastCycles = cycles;
+    dispatchStats.totalCycles += cycles;
+    if (cycles > dispatchStats.maxCycles)
+        dispatchStats.maxCycles = cycles;
+
+    handler->handle(&cmd);
     return 0; // Success
 }
+
+void Packet_GetDispatchStats(PacketDispatchStats *stats)
+{
+    *stats = dispatchStats;
+}
@@ -0,0 +1,71 @@
+#include "PacketCodec.h"
+#include "CheckSum.h"
+#include "FrameParser.h"
+#include <string.h>
+
+/* ==================== Layout Checks ==================== */
+_Static_assert(PACKET_OFFSET_SEQ == PACKET_OFFSET_START + 2, "start marker is two bytes");
+_Static_assert(PACKET_OFFSET_ID == PACKET_OFFSET_SEQ + 1, "seq is one byte");
+_Static_assert(PACKET_OFFSET_LEN == PACKET_OFFSET_ID + 1, "packetID is one byte");
+_Static_assert(PACKET_OFFSET_PAYLOAD == PACKET_OFFSET_LEN + 1, "len is one byte");
+_Static_assert(PACKET_OVERHEAD == 9, "header + crc + end marker");
+_Static_assert(PACKET_MAX_PAYLOAD <= UINT8_MAX, "len is one byte");
+_Static_assert(PACKET_MAX_FRAME_SIZE <= FRAME_PARSER_MAX_LEN, "frame does not fit the parser buffer");
+
+// CRC covers seq, packetID, len and payload, contiguous on the wire
+#define PACKET_CRC_SPAN(len) (3U + (len))
+
+uint16_t PacketCodec_FrameLength(const uint8_t *header)
+{
+    uint8_t len = header[PACKET_OFFSET_LEN];
+    if (len > PACKET_MAX_PAYLOAD)
+        return 0;
+    return PACKET_OVERHEAD + len;
+}
+
+uint8_t PacketCodec_Decode(const uint8_t *frame, uint16_t frameLen, PacketView *view)
+{
+    // Header fields first, a rejected frame is NACKed with them
+    view->seq = frameLen > PACKET_OFFSET_SEQ ? frame[PACKET_OFFSET_SEQ] : 0;
+    view->packetID = frameLen > PACKET_OFFSET_ID ? frame[PACKET_OFFSET_ID] : PACKET_ID_NONE;
+    view->len = 0;
+    view->payload = NULL;
+
+    if (frameLen < PACKET_OVERHEAD)
+        return 1;
+
+    uint8_t len = frame[PACKET_OFFSET_LEN];
+    const uint8_t *crcField = frame + PACKET_OFFSET_PAYLOAD + len;
+
+    if (frameLen != PACKET_OVERHEAD + len ||
+        PacketCodec_GetU16(frame + PACKET_OFFSET_START) != PACKET_START_MARKER ||
+        PacketCodec_GetU16(crcField + PACKET_CRC_SIZE) != PACKET_END_MARKER)
+    {
+        return 1;
+    }
+
+    view->len = len;
+    view->payload = frame + PACKET_OFFSET_PAYLOAD;
+
+    if (PacketCodec_GetU16(crcField) != crc16_table_calc(frame + PACKET_OFFSET_SEQ, PACKET_CRC_SPAN(len)))
+        return 2;
+    return 0;
+}
+
+uint16_t PacketCodec_Encode(uint8_t *frame, uint8_t seq, uint8_t packetID, const uint8_t *payload, uint8_t len)
+{
+    if (len > PACKET_MAX_PAYLOAD)
+        return 0;
+
+    PacketCodec_PutU16(frame + PACKET_OFFSET_START, PACKET_START_MARKER);
+    frame[PACKET_OFFSET_SEQ] = seq;
+    frame[PACKET_OFFSET_ID] = packetID;
+    frame[PACKET_OFFSET_LEN] = len;
+    memcpy(frame + PACKET_OFFSET_PAYLOAD, payload, len);
+
+    uint8_t *crcField = frame + PACKET_OFFSET_PAYLOAD + len;
+    PacketCodec_PutU16(crcField, crc16_table_calc(frame + PACKET_OFFSET_SEQ, PACKET_CRC_SPAN(len)));
+    PacketCodec_PutU16(crcField + PACKET_CRC_SIZE, PACKET_END_MARKER);
+
+    return PACKET_OVERHEAD + len;
+}
@@ -0,0 +1,91 @@
+#include "Power.h"
+#include "Exec.h"
+#include "stm32f4xx_hal.h"
+
+extern TIM_HandleTypeDef htim10;
+
+static uint32_t idleUs = 0;
+static volatile uint8_t wakeEdge = 0;
+
+void Power_Init(void)
+{
+    // Sleep mode: only what keeps running while the core waits. DMA reads
+    // the UART buffers from SRAM, never from flash, so the flash interface stops too.
+    RCC->AHB1LPENR = RCC_AHB1LPENR_GPIOALPEN | RCC_AHB1LPENR_GPIOBLPEN |
+                     RCC_AHB1LPENR_DMA1LPEN | RCC_AHB1LPENR_DMA2LPEN | RCC_AHB1LPENR_SRAM1LPEN;
+    RCC->APB1LPENR = RCC_APB1LPENR_TIM2LPEN | RCC_APB1LPENR_TIM3LPEN | RCC_APB1LPENR_TIM4LPEN |
+                     RCC_APB1LPENR_TIM5LPEN | RCC_APB1LPENR_USART2LPEN;
+    RCC->APB2LPENR = RCC_APB2LPENR_TIM10LPEN | RCC_APB2LPENR_USART1LPEN
+#if UART_CAR_RTOS
+                     | RCC_APB2LPENR_TIM11LPEN // HAL time base
+#endif
+        ;
+
+    // GPIOC / GPIOH are not wired: analog mode disconnects the floating input buffers
+    GPIO_InitTypeDef unused = {.Pin = GPIO_PIN_All, .Mode = GPIO_MODE_ANALOG, .Pull = GPIO_NOPULL};
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    __HAL_RCC_GPIOH_CLK_ENABLE();
+    HAL_GPIO_Init(GPIOC, &unused);
+    HAL_GPIO_Init(GPIOH, &unused);
+    __HAL_RCC_GPIOC_CLK_DISABLE();
+    __HAL_RCC_GPIOH_CLK_DISABLE();
+}
+
+void Power_Idle(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // WFI still wakes on an interrupt that becomes pending while masked
+    if (!Exec_HasPending())
+    {
+        uint32_t period = __HAL_TIM_GET_AUTORELOAD(&htim10) + 1U;
+        uint32_t start = __HAL_TIM_GET_COUNTER(&htim10);
+        __DSB();
+        __WFI();
+        uint32_t end = __HAL_TIM_GET_COUNTER(&htim10);
+        // The TIM10 update wakes the core at the latest, so less than one period passed
+        idleUs += (end + period - start) % period;
+    }
+
+    // The interrupt that woke the core runs here
+    __set_PRIMASK(primask);
+}
+
+uint32_t Power_GetIdleUs(void)
+{
+    return idleUs;
+}
+
+void Power_OnWakeEdge(void)
+{
+    wakeEdge = 1;
+}
+
+void Power_EnterStop(void)
+{
+    // USART2 RX (PA3) as a falling-edge interrupt: the start bit of the next frame
+    GPIO_InitTypeDef pin = {.Pin = GPIO_PIN_3, .Mode = GPIO_MODE_IT_FALLING, .Pull = GPIO_PULLUP};
+    HAL_GPIO_Init(GPIOA, &pin);
+    __HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_3);
+    HAL_NVIC_SetPriority(EXTI3_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(EXTI3_IRQn);
+
+    wakeEdge = 0;
+    HAL_SuspendTick();
+    HAL_PWREx_EnableFlashPowerDown();
+    // Any other interrupt (a log transfer finishing) wakes the core too: back to Stop
+    while (!wakeEdge)
+        HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+    HAL_PWREx_DisableFlashPowerDown();
+    HAL_ResumeTick();
+
+    // PA3 back to USART2 RX, as HAL_UART_MspInit configures it
+    HAL_NVIC_DisableIRQ(EXTI3_IRQn);
+    HAL_GPIO_DeInit(GPIOA, GPIO_PIN_3);
+    pin.Mode = GPIO_MODE_AF_PP;
+    pin.Pull = GPIO_NOPULL;
+    pin.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    pin.Alternate = GPIO_AF7_USART2;
+    HAL_GPIO_Init(GPIOA, &pin);
+}
@@ -0,0 +1,190 @@
+#include "PwmOut.h"
+#include "stm32f4xx_hal.h"
+#include "Log.h"
+#include "Clock.h"
+#include <math.h>
+
+extern TIM_HandleTypeDef htim4;
+
+typedef struct
+{
+    uint32_t channel;       // TIM4 channel
+    GPIO_TypeDef *dirPort;
+    uint16_t dirPin;
+    volatile float target;  // set by motor code
+    volatile float applied; // owned by PwmOut_Tick
+    float step;             // max duty change per tick, 0 = unlimited
+    int8_t direction;       // pin state: 1 set, -1 reset
+    uint8_t zeroSeen;       // applied was 0 when UIF was last cleared
+    uint8_t off;            // a 0 compare has been latched by an update event
+} PwmOut;
+
+static PwmOut outputs[PWM_OUT_COUNT] = {
+    [PWM_OUT_STEER] = {.channel = TIM_CHANNEL_1, .dirPort = GPIOB, .dirPin = GPIO_PIN_7},
+    [PWM_OUT_WHEEL1] = {.channel = TIM_CHANNEL_3, .dirPort = GPIOB, .dirPin = GPIO_PIN_4},
+    [PWM_OUT_WHEEL2] = {.channel = TIM_CHANNEL_4, .dirPort = GPIOB, .dirPin = GPIO_PIN_5},
+};
+
+static uint32_t pwmFrequency; // Hz, as achieved
+
+// TIM4 input clock: PCLK1, doubled by the timer when APB1 is divided
+static uint32_t PwmOut_TimerClock(void)
+{
+    uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+    return ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_CFGR_PPRE1_DIV1) ? pclk1 : 2U * pclk1;
+}
+
+static void PwmOut_Write(PwmOut *out, float duty)
+{
+    uint32_t arr = __HAL_TIM_GET_AUTORELOAD(&htim4);
+    __HAL_TIM_SET_COMPARE(&htim4, out->channel, (uint32_t)(fabsf(duty) * arr));
+    if (duty == 0.0f && out->applied == 0.0f)
+        return; // already off, what is known about the latch still holds
+    out->applied = duty;
+    out->zeroSeen = 0;
+    out->off = 0;
+}
+
+void PwmOut_Init(void)
+{
+    // HAL_TIM_PWM_ConfigChannel already sets OCxPE, made explicit as the ramp relies on it
+    __HAL_TIM_ENABLE_OCxPRELOAD(&htim4, TIM_CHANNEL_1);
+    __HAL_TIM_ENABLE_OCxPRELOAD(&htim4, TIM_CHANNEL_3);
+    __HAL_TIM_ENABLE_OCxPRELOAD(&htim4, TIM_CHANNEL_4);
+
+    PwmOut_SetSlewRate(PWM_OUT_STEER, PWM_OUT_STEER_SLEW);
+    PwmOut_SetSlewRate(PWM_OUT_WHEEL1, PWM_OUT_WHEEL_SLEW);
+    PwmOut_SetSlewRate(PWM_OUT_WHEEL2, PWM_OUT_WHEEL_SLEW);
+
+#if PWM_OUT_INAUDIBLE
+    PwmOut_Configure(PWM_OUT_INAUDIBLE_HZ, PWM_OUT_MIN_STEPS);
+#else
+    PwmOut_Configure(PWM_OUT_AUDIBLE_HZ, PWM_OUT_MIN_STEPS);
+#endif
+
+    for (uint8_t i = 0; i < PWM_OUT_COUNT; i++)
+    {
+        outputs[i].target = 0.0f;
+        PwmOut_Write(&outputs[i], 0.0f);
+        outputs[i].off = 1; // not started yet
+        outputs[i].zeroSeen = 1;
+        outputs[i].direction = (HAL_GPIO_ReadPin(outputs[i].dirPort, outputs[i].dirPin) == GPIO_PIN_SET) ? 1 : -1;
+        HAL_TIM_PWM_Start(&htim4, outputs[i].channel);
+    }
+}
+
+uint8_t PwmOut_Configure(uint32_t frequencyHz, uint16_t minSteps)
+{
+    uint32_t clock = PwmOut_TimerClock();
+    if (frequencyHz == 0 || minSteps == 0 || frequencyHz > clock / minSteps)
+        return 0;
+
+    // Smallest prescaler whose period fits the 16-bit counter
+    uint32_t cyclesPerPeriod = clock / frequencyHz;
+    uint32_t prescaler = (cyclesPerPeriod - 1U) / 65536U; // PSC register value
+    uint32_t period = (clock + frequencyHz * (prescaler + 1U) / 2U) / (frequencyHz * (prescaler + 1U));
+    if (period < minSteps || period > 65536U || prescaler > 0xFFFFU)
+        return 0;
+
+    // UDIS holds the preloads: PSC, ARR and the rescaled CCRs switch on the same update
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    htim4.Instance->CR1 |= TIM_CR1_UDIS;
+    __HAL_TIM_SET_PRESCALER(&htim4, prescaler);
+    __HAL_TIM_SET_AUTORELOAD(&htim4, period - 1U);
+    for (uint8_t i = 0; i < PWM_OUT_COUNT; i++)
+    {
+        uint32_t compare = (uint32_t)(fabsf(outputs[i].applied) * (period - 1U));
+        __HAL_TIM_SET_COMPARE(&htim4, outputs[i].channel, compare);
+    }
+    htim4.Instance->CR1 &= ~TIM_CR1_UDIS;
+    __set_PRIMASK(primask);
+
+    pwmFrequency = clock / ((prescaler + 1U) * period);
+    LOG(PWM_CONFIG, pwmFrequency, prescaler, period);
+    return 1;
+}
+
+uint8_t PwmOut_SetInaudible(uint8_t enable)
+{
+    return PwmOut_Configure(enable ? PWM_OUT_INAUDIBLE_HZ : PWM_OUT_AUDIBLE_HZ, PWM_OUT_MIN_STEPS);
+}
+
+void PwmOut_GetConfig(uint32_t *frequencyHz, uint32_t *steps)
+{
+    *frequencyHz = pwmFrequency;
+    *steps = __HAL_TIM_GET_AUTORELOAD(&htim4) + 1U;
+}
+
+void PwmOut_Set(PwmOutChannel ch, float duty)
+{
+    if (duty > 1.0f)
+        duty = 1.0f;
+    else if (duty < -1.0f)
+        duty = -1.0f;
+    outputs[ch].target = duty;
+}
+
+void PwmOut_Stop(PwmOutChannel ch)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    outputs[ch].target = 0.0f;
+    PwmOut_Write(&outputs[ch], 0.0f);
+    __set_PRIMASK(primask);
+}
+
+void PwmOut_SetSlewRate(PwmOutChannel ch, float dutyPerSecond)
+{
+    outputs[ch].step = dutyPerSecond / PWM_OUT_TICK_HZ;
+}
+
+float PwmOut_Get(PwmOutChannel ch)
+{
+    return outputs[ch].applied;
+}
+
+HOT_FUNC void PwmOut_Tick(void)
+{
+    // UIF is only polled here (no TIM4 interrupt): an update event since the last tick
+    uint8_t updated = __HAL_TIM_GET_FLAG(&htim4, TIM_FLAG_UPDATE) != RESET;
+    if (updated)
+        __HAL_TIM_CLEAR_FLAG(&htim4, TIM_FLAG_UPDATE);
+
+    for (uint8_t i = 0; i < PWM_OUT_COUNT; i++)
+    {
+        PwmOut *out = &outputs[i];
+        float target = out->target;
+        float applied = out->applied;
+
+        // An update after a UIF clear that followed the 0 write has latched it
+        if (applied == 0.0f)
+        {
+            if (updated && out->zeroSeen)
+                out->off = 1;
+            out->zeroSeen = 1;
+        }
+        if (target == applied)
+            continue;
+
+        // Reversing: head for 0 first, the pin only flips with the output off
+        uint8_t reversing = (applied > 0.0f && target < 0.0f) || (applied < 0.0f && target > 0.0f);
+        float goal = reversing ? 0.0f : target;
+
+        float next = goal;
+        if (out->step > 0.0f && fabsf(goal - applied) > out->step)
+            next = applied + ((goal > applied) ? out->step : -out->step);
+
+        int8_t direction = (next > 0.0f) ? 1 : -1;
+        if (next != 0.0f && direction != out->direction)
+        {
+            // The preloaded 0 only takes effect at the update event, flip after it
+            if (!out->off)
+                continue;
+            HAL_GPIO_WritePin(out->dirPort, out->dirPin, (direction > 0) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+            out->direction = direction;
+        }
+
+        PwmOut_Write(out, next);
+    }
+}
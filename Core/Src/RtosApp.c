@@ -0,0 +1,187 @@
+#include "RtosApp.h"
+#include "cmsis_os2.h"
+#include "main.h"
+#include "Log.h"
+#include "Encoder.h"
+#include "Motor_Angle.h"
+#include "Speed_Motor.h"
+#include "Deadman.h"
+
+extern TIM_HandleTypeDef htim10;
+
+#define FLAG_RELEASE 0x01U
+
+typedef struct
+{
+    int32_t steerPosition;
+    int32_t atTarget;
+    int32_t rpm1;
+    int32_t rpm2;
+    int32_t deadmanTripped;
+} TelemetrySample;
+
+static const RtosAppTasks *appTasks;
+
+static osThreadId_t controlThread;
+static osThreadId_t actuatorThread;
+static osThreadId_t linkThread;
+static osThreadId_t logThread;
+static osMessageQueueId_t telemetryQueue;
+
+static volatile uint32_t telemetryDrops = 0;
+
+static const osThreadAttr_t controlAttr = {
+    .name = "control", .priority = osPriorityRealtime, .stack_size = 1024,
+};
+static const osThreadAttr_t actuatorAttr = {
+    .name = "actuators", .priority = osPriorityHigh, .stack_size = 768,
+};
+static const osThreadAttr_t linkAttr = {
+    .name = "link", .priority = osPriorityAboveNormal, .stack_size = 1536,
+};
+static const osThreadAttr_t logAttr = {
+    .name = "log", .priority = osPriorityBelowNormal, .stack_size = 768,
+};
+
+/* ==================== Threads ==================== */
+
+static void RtosApp_Control(void *arg)
+{
+    (void)arg;
+    uint8_t telemetryDivider = 0;
+
+    // Started here so the first release finds this thread waiting
+    HAL_TIM_Base_Start_IT(&htim10);
+
+    for (;;)
+    {
+        osThreadFlagsWait(FLAG_RELEASE, osFlagsWaitAny, osWaitForever);
+        appTasks->control();
+        osThreadFlagsSet(actuatorThread, FLAG_RELEASE);
+
+        if (++telemetryDivider < RTOS_APP_TELEMETRY_DIVIDER)
+            continue;
+        telemetryDivider = 0;
+
+        // Sampled between two control runs, so every field is from the same tick
+        TelemetrySample sample = {
+            .steerPosition = (int32_t)Encoder_GetPosition(ENCODER_STEER),
+            .atTarget = Motor_Angle_AtTarget(),
+            .rpm1 = (int32_t)Motor_GetRpm(1),
+            .rpm2 = (int32_t)Motor_GetRpm(2),
+            .deadmanTripped = Deadman_IsTripped(),
+        };
+        if (osMessageQueuePut(telemetryQueue, &sample, 0, 0) != osOK)
+            telemetryDrops++;
+    }
+}
+
+static void RtosApp_Actuators(void *arg)
+{
+    (void)arg;
+    for (;;)
+    {
+        osThreadFlagsWait(FLAG_RELEASE, osFlagsWaitAny, osWaitForever);
+        appTasks->actuators();
+    }
+}
+
+static void RtosApp_Link(void *arg)
+{
+    (void)arg;
+    uint32_t housekeepingTicks = RTOS_APP_HOUSEKEEPING_MS * osKernelGetTickFreq() / 1000U;
+    uint32_t nextHousekeeping = osKernelGetTickCount() + housekeepingTicks;
+
+    for (;;)
+    {
+        uint32_t wait = nextHousekeeping - osKernelGetTickCount();
+        if ((int32_t)wait > 0)
+            osThreadFlagsWait(FLAG_RELEASE, osFlagsWaitAny, wait);
+
+        // Also run on a timeout: a frame may have landed before the flag was waited on
+        appTasks->commands();
+
+        if ((int32_t)(osKernelGetTickCount() - nextHousekeeping) >= 0)
+        {
+            nextHousekeeping += housekeepingTicks;
+            appTasks->housekeeping();
+        }
+    }
+}
+
+static void RtosApp_Log(void *arg)
+{
+    (void)arg;
+    TelemetrySample sample;
+    for (;;)
+    {
+        if (osMessageQueueGet(telemetryQueue, &sample, NULL, osWaitForever) != osOK)
+            continue;
+        LOG(TELEMETRY, sample.steerPosition, sample.atTarget, sample.rpm1, sample.rpm2,
+            sample.deadmanTripped);
+    }
+}
+
+/* ==================== Public API ==================== */
+
+void RtosApp_Start(const RtosAppTasks *tasks)
+{
+    appTasks = tasks;
+
+    // Interrupts that release threads must sit below the kernel's masking level
+    HAL_NVIC_SetPriority(TIM1_UP_TIM10_IRQn, RTOS_APP_IRQ_PRIORITY, 0);
+    HAL_NVIC_SetPriority(USART2_IRQn, RTOS_APP_IRQ_PRIORITY, 0);
+    HAL_NVIC_SetPriority(DMA1_Stream5_IRQn, RTOS_APP_IRQ_PRIORITY, 0);
+
+    osKernelInitialize();
+    telemetryQueue = osMessageQueueNew(RTOS_APP_TELEMETRY_DEPTH, sizeof(TelemetrySample), NULL);
+    actuatorThread = osThreadNew(RtosApp_Actuators, NULL, &actuatorAttr);
+    linkThread = osThreadNew(RtosApp_Link, NULL, &linkAttr);
+    logThread = osThreadNew(RtosApp_Log, NULL, &logAttr);
+    controlThread = osThreadNew(RtosApp_Control, NULL, &controlAttr);
+
+    if (telemetryQueue == NULL || controlThread == NULL || actuatorThread == NULL ||
+        linkThread == NULL || logThread == NULL)
+    {
+        LOG(RTOS_START_FAILED);
+        Error_Handler();
+    }
+    osKernelStart();
+    Error_Handler();
+}
+
+void RtosApp_OnTick(void)
+{
+    if (controlThread != NULL)
+        osThreadFlagsSet(controlThread, FLAG_RELEASE);
+}
+
+void RtosApp_OnRx(void)
+{
+    if (linkThread != NULL)
+        osThreadFlagsSet(linkThread, FLAG_RELEASE);
+}
+
+uint32_t RtosApp_GetTelemetryDrops(void)
+{
+    return telemetryDrops;
+}
+
+// Threads sleep instead of spinning, so a blocking HAL_Delay no longer holds up lower priorities
+void HAL_Delay(uint32_t Delay)
+{
+    if (osKernelGetState() == osKernelRunning && __get_IPSR() == 0U)
+    {
+        // One extra tick guarantees at least Delay ms, as the HAL version does
+        osDelay((Delay * osKernelGetTickFreq() + 999U) / 1000U + 1U);
+        return;
+    }
+
+    uint32_t start = HAL_GetTick();
+    uint32_t wait = Delay;
+    if (wait < HAL_MAX_DELAY)
+        wait += (uint32_t)uwTickFreq;
+    while ((HAL_GetTick() - start) < wait)
+    {
+    }
+}
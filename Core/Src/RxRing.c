@@ -0,0 +1,28 @@
+#include "RxRing.h"
+
+uint8_t RxRing_Advance(uint16_t *tail, uint16_t head, uint16_t size, RxSpan spans[2])
+{
+    uint8_t count = 0;
+    uint16_t from = *tail;
+
+    if (head > size || from >= size)
+        return 0;
+
+    // DMA wrapped since the last event: the end of the buffer comes first
+    if (head < from)
+    {
+        spans[count].start = from;
+        spans[count].len = size - from;
+        count++;
+        from = 0;
+    }
+    if (head > from)
+    {
+        spans[count].start = from;
+        spans[count].len = head - from;
+        count++;
+    }
+
+    *tail = (head == size) ? 0 : head;
+    return count;
+}
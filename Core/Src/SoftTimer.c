@@ -0,0 +1,54 @@
+#include "SoftTimer.h"
+#include "stm32f4xx_hal.h"
+
+typedef struct
+{
+    uint32_t remaining; // ms left, 0 = stopped
+    SoftTimerCallback callback;
+    void *arg;
+} SoftTimer;
+
+// Changed by the main loop with interrupts masked, counted down by the tick
+static SoftTimer timers[SOFT_TIMER_COUNT];
+
+void SoftTimer_Init(void)
+{
+    for (uint8_t i = 0; i < SOFT_TIMER_COUNT; i++)
+        SoftTimer_Stop((SoftTimerId)i);
+}
+
+void SoftTimer_Start(SoftTimerId id, uint32_t ms, SoftTimerCallback callback, void *arg)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    timers[id].callback = callback;
+    timers[id].arg = arg;
+    timers[id].remaining = ms;
+    __set_PRIMASK(primask);
+}
+
+void SoftTimer_Stop(SoftTimerId id)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    timers[id].remaining = 0;
+    __set_PRIMASK(primask);
+}
+
+uint8_t SoftTimer_IsRunning(SoftTimerId id)
+{
+    return timers[id].remaining != 0;
+}
+
+void SoftTimer_Tick(void)
+{
+    for (uint8_t i = 0; i < SOFT_TIMER_COUNT; i++)
+    {
+        SoftTimer *timer = &timers[i];
+        if (timer->remaining == 0 || --timer->remaining != 0)
+            continue;
+
+        if (timer->callback)
+            timer->callback(timer->arg);
+    }
+}
@@ -1,131 +1,194 @@
 #include "Speed_Motor.h"
 
 #include "stm32f4xx_hal.h"
-#include "uart.h"
-#include <stdio.h>
-
-// External handles (defined in main.c)
-extern TIM_HandleTypeDef htim1;
-extern TIM_HandleTypeDef htim2;
-extern TIM_HandleTypeDef htim5;
-extern UART_HandleTypeDef huart1;
-extern TIM_HandleTypeDef htim4;
-
-// PWM mapping
-#define MOTOR1_PWM_TIMER &htim4
-#define MOTOR1_PWM_CHANNEL TIM_CHANNEL_3
-#define MOTOR2_PWM_TIMER &htim4
-#define MOTOR2_PWM_CHANNEL TIM_CHANNEL_4
-
-// Direction pins
-#define MOTOR1_DIR_PORT GPIOB
-#define MOTOR1_DIR_PIN GPIO_PIN_4
-#define MOTOR2_DIR_PORT GPIOB
-#define MOTOR2_DIR_PIN GPIO_PIN_5
-
-// -------------------- Encoder functions --------------------
-
-int32_t Encoder_ReadPosition(uint8_t motorID)
+#include "Log.h"
+#include "SoftTimer.h"
+#include "Encoder.h"
+#include "PwmOut.h"
+#include "arm_math.h"
+#include <math.h>
+
+// -------------------- Speed control --------------------
+
+#define WHEEL_COUNT 2
+
+// Per wheel, index = motorID - 1; pid is owned by the control tick
+static arm_pid_instance_f32 wheelPid[WHEEL_COUNT];
+static volatile float wheelTargetRpm[WHEEL_COUNT];
+static volatile float wheelRpm[WHEEL_COUNT];
+static volatile uint8_t wheelActive[WHEEL_COUNT];
+static volatile uint8_t wheelNewTarget[WHEEL_COUNT];
+static volatile float wheelDuty[WHEEL_COUNT];     // last commanded, signed
+static volatile uint8_t wheelRamping[WHEEL_COUNT]; // Motor_RampToStop in progress
+static volatile float wheelRampStep;              // duty per speed sample
+
+// Signed duty [-1..1] on one wheel, positive sets the direction pin (slew limited by PwmOut)
+static void Motor_ApplyDuty(uint8_t wheel, float duty)
 {
-    if (motorID == 1)
+    PwmOut_Set((wheel == 0) ? PWM_OUT_WHEEL1 : PWM_OUT_WHEEL2, duty);
+    wheelDuty[wheel] = duty;
+}
+
+// One speed sample of a ramp towards zero, keeps the direction until it gets there
+static void Motor_RampStep(uint8_t wheel)
+{
+    float duty = wheelDuty[wheel];
+    float step = wheelRampStep;
+
+    if (fabsf(duty) <= step)
     {
-        return (int16_t)__HAL_TIM_GET_COUNTER(&htim2); // Encoder 1
+        wheelRamping[wheel] = 0;
+        Motor_ApplyDuty(wheel, 0.0f);
+        return;
     }
-    else if (motorID == 2)
+    Motor_ApplyDuty(wheel, (duty > 0.0f) ? duty - step : duty + step);
+}
+
+void Motor_SetRpm(uint8_t motorID, int16_t rpm)
+{
+    for (uint8_t wheel = 0; wheel < WHEEL_COUNT; wheel++)
     {
-        return (int16_t)__HAL_TIM_GET_COUNTER(&htim5); // Encoder 2
+        if (motorID != wheel + 1U && motorID != 3)
+            continue;
+
+        SoftTimer_Stop((wheel == 0) ? SOFT_TIMER_MOTOR1 : SOFT_TIMER_MOTOR2);
+        wheelRamping[wheel] = 0;
+        wheelTargetRpm[wheel] = rpm;
+        wheelNewTarget[wheel] = 1;
+        wheelActive[wheel] = (rpm != 0);
+        if (rpm == 0)
+            Motor_ApplyDuty(wheel, 0.0f);
     }
-    return 0;
 }
 
-float Encoder_ReadSpeed(uint8_t motorID, uint16_t counts_per_rev, float dt_sec)
+float Motor_GetRpm(uint8_t motorID)
 {
-    static int16_t last_count_motor1 = 0;
-    static int16_t last_count_motor2 = 0;
+    return (motorID == 2) ? wheelRpm[1] : wheelRpm[0];
+}
 
-    int16_t count, diff;
-    if (motorID == 1)
-    {
-        count = (int16_t)__HAL_TIM_GET_COUNTER(&htim2);
-        diff = count - last_count_motor1;
-        last_count_motor1 = count;
-    }
-    else
+void Motor_SpeedControlTick(void)
+{
+    for (uint8_t wheel = 0; wheel < WHEEL_COUNT; wheel++)
     {
-        count = (int16_t)__HAL_TIM_GET_COUNTER(&htim5);
-        diff = count - last_count_motor2;
-        last_count_motor2 = count;
+        // Measured every sample so the estimate is fresh when a target arrives
+        float rpm = Encoder_GetVelocity(wheel ? ENCODER_WHEEL2 : ENCODER_WHEEL1) * 60.0f / WHEEL_COUNTS_PER_REV;
+        wheelRpm[wheel] = rpm;
+
+        if (wheelNewTarget[wheel])
+        {
+            wheelNewTarget[wheel] = 0;
+            arm_pid_reset_f32(&wheelPid[wheel]);
+        }
+        if (wheelRamping[wheel])
+            Motor_RampStep(wheel);
+        if (!wheelActive[wheel])
+            continue;
+
+        // Feed-forward from the target, the PID only corrects load and battery drift
+        float target = wheelTargetRpm[wheel];
+        float feedForward = target / WHEEL_MAX_RPM;
+        float correction = arm_pid_f32(&wheelPid[wheel], target - rpm);
+
+        float duty = feedForward + correction;
+        if (duty > 1.0f)
+            duty = 1.0f;
+        else if (duty < -1.0f)
+            duty = -1.0f;
+        // Anti-windup: keep the PID output consistent with what was applied
+        wheelPid[wheel].state[2] = duty - feedForward;
+
+        Motor_ApplyDuty(wheel, duty);
     }
-
-    float revs = (float)diff / counts_per_rev;
-    return (revs / dt_sec) * 60.0f; // RPM
 }
 
 // -------------------- Motor control --------------------
 
 void Motor_init()
 {
-    HAL_TIM_PWM_Start(&htim4, TIM_CHANNEL_3);
-    HAL_TIM_PWM_Start(&htim4, TIM_CHANNEL_4);
-}
-
-void Motor_SetSpeed(uint8_t motorID, uint8_t speed, uint8_t direction)
-{
-    uint32_t arr;
-    int16_t encoder_value;
-    char msg[100];
 
-    // Motor 1 only
-    if (motorID == 1 || motorID == 3)
+    for (uint8_t wheel = 0; wheel < WHEEL_COUNT; wheel++)
     {
-        HAL_GPIO_WritePin(MOTOR1_DIR_PORT, MOTOR1_DIR_PIN,
-                          direction ? GPIO_PIN_SET : GPIO_PIN_RESET);
-
-        arr = __HAL_TIM_GET_AUTORELOAD(MOTOR1_PWM_TIMER);
-        __HAL_TIM_SET_COMPARE(MOTOR1_PWM_TIMER, MOTOR1_PWM_CHANNEL,
-                              (arr * speed) / 100);
-
-        encoder_value = Encoder_ReadPosition(1);
-        snprintf(msg, sizeof(msg),
-                 "Motor 1 Enc=%d, PWM=%d%%, Dir=%d\r\n",
-                 encoder_value, speed, direction);
-        HAL_UART_Transmit_IT(&huart1, (uint8_t *)msg, strlen(msg)); // non-blocking
+        wheelPid[wheel].Kp = WHEEL_KP;
+        wheelPid[wheel].Ki = WHEEL_KI;
+        wheelPid[wheel].Kd = WHEEL_KD;
+        arm_pid_init_f32(&wheelPid[wheel], 1);
+        wheelActive[wheel] = 0;
     }
+}
 
-    // Motor 2 only
-    if (motorID == 2 || motorID == 3)
+// SoftTimer callback, arg = wheel index
+static void Motor_TimedStop(void *arg)
+{
+    uint8_t wheel = (uint8_t)(uintptr_t)arg;
+    wheelActive[wheel] = 0;
+    Motor_ApplyDuty(wheel, 0.0f);
+}
+
+void Motor_Drive(uint8_t motorID, uint8_t speed, uint8_t direction, uint16_t duration_ms)
+{
+    for (uint8_t wheel = 0; wheel < WHEEL_COUNT; wheel++)
     {
-        HAL_GPIO_WritePin(MOTOR2_DIR_PORT, MOTOR2_DIR_PIN,
-                          direction ? GPIO_PIN_SET : GPIO_PIN_RESET);
-
-        arr = __HAL_TIM_GET_AUTORELOAD(MOTOR2_PWM_TIMER);
-        __HAL_TIM_SET_COMPARE(MOTOR2_PWM_TIMER, MOTOR2_PWM_CHANNEL,
-                              (arr * speed) / 100);
-
-        encoder_value = Encoder_ReadPosition(2);
-        snprintf(msg, sizeof(msg),
-                 "Motor 2 Enc=%d, PWM=%d%%, Dir=%d\r\n",
-                 encoder_value, speed, direction);
-        HAL_UART_Transmit_IT(&huart1, (uint8_t *)msg, strlen(msg)); // non-blocking
+        if (motorID != wheel + 1U && motorID != 3)
+            continue;
+
+        // Supersedes any closed-loop target, ramp or pending timed stop on this wheel
+        wheelActive[wheel] = 0;
+        wheelRamping[wheel] = 0;
+        float duty = speed / 100.0f;
+        Motor_ApplyDuty(wheel, direction ? duty : -duty);
+
+        SoftTimerId timer = (wheel == 0) ? SOFT_TIMER_MOTOR1 : SOFT_TIMER_MOTOR2;
+        if (duration_ms != 0)
+            SoftTimer_Start(timer, duration_ms, Motor_TimedStop, (void *)(uintptr_t)wheel);
+        else
+            SoftTimer_Stop(timer);
+
+        LOG(MOTOR_SPEED, wheel + 1, (int32_t)Encoder_GetPosition(wheel ? ENCODER_WHEEL2 : ENCODER_WHEEL1), speed, direction);
     }
+}
 
-    Motor_Stop(motorID);
+void Motor_SetSpeed(uint8_t motorID, uint8_t speed, uint8_t direction)
+{
+    // Same 500 ms pulse as before, without blocking
+    Motor_Drive(motorID, speed, direction, MOTOR_DEFAULT_PULSE_MS);
 }
 
 void Motor_Stop(uint8_t motorID)
 {
-    HAL_Delay(500);
-    if (motorID == 1)
+    for (uint8_t wheel = 0; wheel < WHEEL_COUNT; wheel++)
     {
-        __HAL_TIM_SET_COMPARE(MOTOR1_PWM_TIMER, MOTOR1_PWM_CHANNEL, 0);
+        if (motorID != wheel + 1U && motorID != 3)
+            continue;
+
+        SoftTimer_Stop((wheel == 0) ? SOFT_TIMER_MOTOR1 : SOFT_TIMER_MOTOR2);
+        wheelActive[wheel] = 0;
+        wheelRamping[wheel] = 0;
+        Motor_ApplyDuty(wheel, 0.0f);
     }
-    else if (motorID == 2)
+}
+
+void Motor_RampToStop(uint8_t motorID, uint16_t ramp_ms)
+{
+    if (ramp_ms == 0)
     {
-        __HAL_TIM_SET_COMPARE(MOTOR2_PWM_TIMER, MOTOR2_PWM_CHANNEL, 0);
+        Motor_Stop(motorID);
+        return;
     }
-    else if (motorID == 3)
+
+    // Full scale to zero in ramp_ms, smaller duties get there sooner
+    wheelRampStep = 1000.0f / ((float)ramp_ms * WHEEL_CONTROL_HZ);
+    for (uint8_t wheel = 0; wheel < WHEEL_COUNT; wheel++)
     {
-        __HAL_TIM_SET_COMPARE(MOTOR1_PWM_TIMER, MOTOR1_PWM_CHANNEL, 0);
-        __HAL_TIM_SET_COMPARE(MOTOR2_PWM_TIMER, MOTOR2_PWM_CHANNEL, 0);
+        if (motorID != wheel + 1U && motorID != 3)
+            continue;
+
+        SoftTimer_Stop((wheel == 0) ? SOFT_TIMER_MOTOR1 : SOFT_TIMER_MOTOR2);
+        wheelActive[wheel] = 0;
+        wheelRamping[wheel] = 1;
     }
-}
\ No newline at end of file
+}
+
+uint8_t Motor_IsStopped(void)
+{
+    return PwmOut_Get(PWM_OUT_WHEEL1) == 0.0f && PwmOut_Get(PWM_OUT_WHEEL2) == 0.0f;
+}
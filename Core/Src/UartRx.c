@@ -0,0 +1,88 @@
+#include "UartRx.h"
+#include "PacketCodec.h"
+#include "FrameQueue.h"
+#include "FrameParser.h"
+#include "RxRing.h"
+
+static UART_HandleTypeDef *rx_huart;
+
+#if UART_RX_MODE == UART_RX_MODE_DMA
+static uint8_t dmaBuffer[UART_RX_DMA_BUF_SIZE];
+static uint16_t dmaTail = 0; // next byte of dmaBuffer not yet framed
+#else
+static uint8_t rxByte;
+#endif
+
+static void UartRx_OnFrame(const uint8_t *frame, uint16_t len);
+
+static const FrameParserConfig packetFraming = {
+    .startMarker = PACKET_START_MARKER,
+    .endMarker = PACKET_END_MARKER,
+    .headerLen = PACKET_HEADER_SIZE,
+    .lengthOf = PacketCodec_FrameLength,
+    .onFrame = UartRx_OnFrame,
+};
+
+static FrameParser parser; // fed from the receive ISR only
+
+/* ==================== Framing ==================== */
+
+static void UartRx_OnFrame(const uint8_t *frame, uint16_t len)
+{
+    // A full queue counts the frame as an overflow, reception goes on
+    FrameQueue_Push(frame, (uint8_t)len);
+}
+
+static void UartRx_Start(void)
+{
+#if UART_RX_MODE == UART_RX_MODE_DMA
+    dmaTail = 0;
+    HAL_UARTEx_ReceiveToIdle_DMA(rx_huart, dmaBuffer, UART_RX_DMA_BUF_SIZE);
+    // Only IDLE and wrap-around (TC) events, no half-transfer interrupt
+    __HAL_DMA_DISABLE_IT(rx_huart->hdmarx, DMA_IT_HT);
+#else
+    HAL_UART_Receive_IT(rx_huart, &rxByte, 1);
+#endif
+}
+
+/* ==================== Public API ==================== */
+
+void UartRx_Init(UART_HandleTypeDef *huart)
+{
+    rx_huart = huart;
+    FrameParser_Init(&parser, &packetFraming);
+    UartRx_Start();
+}
+
+void UartRx_OnEvent(uint16_t head)
+{
+#if UART_RX_MODE == UART_RX_MODE_DMA
+    RxSpan spans[2];
+    uint8_t count = RxRing_Advance(&dmaTail, head, UART_RX_DMA_BUF_SIZE, spans);
+
+    for (uint8_t i = 0; i < count; i++)
+        FrameParser_Push(&parser, &dmaBuffer[spans[i].start], spans[i].len);
+#else
+    (void)head;
+#endif
+}
+
+void UartRx_OnRxCplt(void)
+{
+#if UART_RX_MODE == UART_RX_MODE_IT
+    FrameParser_PushByte(&parser, rxByte);
+    HAL_UART_Receive_IT(rx_huart, &rxByte, 1);
+#endif
+}
+
+void UartRx_OnError(void)
+{
+    // Overrun aborts the transfer; noise/framing errors leave it running
+    if (rx_huart && rx_huart->RxState == HAL_UART_STATE_READY)
+        UartRx_Start();
+}
+
+void UartRx_GetParserStats(FrameParserStats *stats)
+{
+    *stats = parser.stats;
+}
@@ -0,0 +1,143 @@
+#include "UartTx.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#define UART_TX_MASK (UART_TX_DEPTH - 1U)
+
+_Static_assert((UART_TX_DEPTH & UART_TX_MASK) == 0, "UART_TX_DEPTH must be a power of two");
+
+typedef struct
+{
+    uint16_t len;
+    uint8_t data[UART_TX_SLOT_SIZE];
+} TxSlot;
+
+static UART_HandleTypeDef *tx_huart;
+static TxSlot slots[UART_TX_DEPTH];
+
+// Free-running indexes, slot = index & UART_TX_MASK
+static _Atomic uint32_t head; // written by the producer only
+static _Atomic uint32_t tail; // written by the ISR only, slot at tail is on the wire
+static volatile uint8_t busy; // DMA transfer running, changed with interrupts masked
+
+// Written by the producer only
+static volatile uint32_t highWater;
+static volatile uint32_t dropped;
+// Written by the ISR only
+static volatile uint32_t sent;
+static volatile uint32_t aborted;
+
+// Caller masks interrupts or runs in the ISR
+static void UartTx_StartNext(void)
+{
+    uint32_t t = atomic_load_explicit(&tail, memory_order_relaxed);
+    // Acquire: pairs with the release in UartTx_Send
+    uint32_t h = atomic_load_explicit(&head, memory_order_acquire);
+
+    if (h == t)
+    {
+        busy = 0;
+        return;
+    }
+
+    TxSlot *slot = &slots[t & UART_TX_MASK];
+    busy = 1;
+    if (HAL_UART_Transmit_DMA(tx_huart, slot->data, slot->len) != HAL_OK)
+    {
+        // Peripheral not ready, UartTx_OnError or the next UartTx_Send retries
+        busy = 0;
+    }
+}
+
+// Frees the slot at tail, ISR context
+static void UartTx_Advance(void)
+{
+    uint32_t t = atomic_load_explicit(&tail, memory_order_relaxed);
+    if (t == atomic_load_explicit(&head, memory_order_acquire))
+        return;
+    // Release: DMA is done reading the slot
+    atomic_store_explicit(&tail, t + 1U, memory_order_release);
+}
+
+/* ==================== Public API ==================== */
+
+void UartTx_Init(UART_HandleTypeDef *huart)
+{
+    tx_huart = huart;
+    atomic_store_explicit(&head, 0, memory_order_relaxed);
+    atomic_store_explicit(&tail, 0, memory_order_relaxed);
+    busy = 0;
+    highWater = 0;
+    dropped = 0;
+    sent = 0;
+    aborted = 0;
+}
+
+uint8_t UartTx_Send(const uint8_t *data, uint16_t len)
+{
+    uint32_t h = atomic_load_explicit(&head, memory_order_relaxed);
+    // Acquire: the DMA is done with the slot the ISR released
+    uint32_t t = atomic_load_explicit(&tail, memory_order_acquire);
+
+    if (h - t >= UART_TX_DEPTH || len == 0 || len > UART_TX_SLOT_SIZE)
+    {
+        dropped++;
+        return 0;
+    }
+
+    TxSlot *slot = &slots[h & UART_TX_MASK];
+    memcpy(slot->data, data, len);
+    slot->len = len;
+
+    // Release: slot contents are visible before the new head
+    atomic_store_explicit(&head, h + 1U, memory_order_release);
+
+    if (h + 1U - t > highWater)
+        highWater = h + 1U - t;
+
+    // Only start the DMA when idle, otherwise the completion ISR picks the slot up
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!busy)
+        UartTx_StartNext();
+    __set_PRIMASK(primask);
+
+    return 1;
+}
+
+uint32_t UartTx_Free(void)
+{
+    uint32_t t = atomic_load_explicit(&tail, memory_order_acquire);
+    uint32_t h = atomic_load_explicit(&head, memory_order_relaxed);
+    return UART_TX_DEPTH - (h - t);
+}
+
+void UartTx_OnTxCplt(void)
+{
+    UartTx_Advance();
+    sent++;
+    UartTx_StartNext();
+}
+
+void UartTx_OnError(void)
+{
+    // A DMA error aborts the transfer; noise/framing errors on RX leave TX running
+    if (busy && tx_huart->gState == HAL_UART_STATE_READY)
+    {
+        UartTx_Advance();
+        aborted++;
+        UartTx_StartNext();
+    }
+}
+
+void UartTx_GetStats(UartTxStats *stats)
+{
+    uint32_t t = atomic_load_explicit(&tail, memory_order_acquire);
+    uint32_t h = atomic_load_explicit(&head, memory_order_acquire);
+
+    stats->depth = h - t;
+    stats->highWater = highWater;
+    stats->dropped = dropped;
+    stats->sent = sent;
+    stats->aborted = aborted;
+}
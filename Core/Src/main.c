@@ -21,7 +21,7 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-
+#include "Clock.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -44,9 +44,13 @@ TIM_HandleTypeDef htim2;
 TIM_HandleTypeDef htim3;
 TIM_HandleTypeDef htim4;
 TIM_HandleTypeDef htim5;
+TIM_HandleTypeDef htim10;
 
 UART_HandleTypeDef huart1;
 UART_HandleTypeDef huart2;
+DMA_HandleTypeDef hdma_usart1_tx;
+DMA_HandleTypeDef hdma_usart2_rx;
+DMA_HandleTypeDef hdma_usart2_tx;
 
 /* USER CODE BEGIN PV */
 
@@ -55,12 +59,14 @@ UART_HandleTypeDef huart2;
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
 static void MX_USART2_UART_Init(void);
 static void MX_USART1_UART_Init(void);
 static void MX_TIM3_Init(void);
 static void MX_TIM4_Init(void);
 static void MX_TIM2_Init(void);
 static void MX_TIM5_Init(void);
+static void MX_TIM10_Init(void);
 /* USER CODE BEGIN PFP */
 
 /* USER CODE END PFP */
@@ -70,78 +76,287 @@ static void MX_TIM5_Init(void);
 #include "string.h"
 #include "main.h"
 #include "Packet.h"
-#include "uart.h" // Include for uart_log_printf
+#include "Log.h"
 #include "Motor_Angle.h"
 #include "Speed_Motor.h"
 #include "Horn.h"
 #include "Light.h"
+#include "UartRx.h"
+#include "UartTx.h"
+#include "FrameQueue.h"
+#include "Link.h"
+#include "CycleCounter.h"
+#include "SoftTimer.h"
+#include "Encoder.h"
+#include "Deadman.h"
+#include "PwmOut.h"
+#include "Exec.h"
+#include "Power.h"
+#include "Bench.h"
+#if UART_CAR_RTOS
+#include "RtosApp.h"
+#endif
 
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance == USART2)
+  {
+    UartRx_OnRxCplt();
+#if UART_CAR_RTOS
+    RtosApp_OnRx();
+#endif
+  }
+}
 
-volatile uint8_t rxBuffer[sizeof(struct Packet)];
-volatile uint8_t rxIndex = 0;
-volatile uint8_t packetReceivedFlag = 0;
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+  if (huart->Instance == USART2)
+  {
+    // Size is the DMA write position in the circular buffer
+    UartRx_OnEvent(Size);
+#if UART_CAR_RTOS
+    RtosApp_OnRx();
+#endif
+  }
+}
 
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
   if (huart->Instance == USART2)
   {
-    // The byte that just arrived is already in the location pointed to by the previous HAL_UART_Receive_IT call.
-    // So, the byte is at rxBuffer[rxIndex].
+    UartRx_OnError();
+    UartTx_OnError();
+  }
+  else if (huart->Instance == USART1)
+  {
+    Log_OnError();
+  }
+}
 
-    // Check for start bytes for synchronization
-    if (rxIndex == 0)
-    {
-      // First byte received. Check if it's the start of a packet (0x55)
-      if (rxBuffer[0] != 0x55)
-      {
-        // Not a start byte, reset index and prepare to receive the first byte again
-        rxIndex = 0;
-        HAL_UART_Receive_IT(&huart2, &rxBuffer[0], 1); // Restart reception for the first byte
-        return;                                        // Exit callback
-      }
-    }
-    else if (rxIndex == 1)
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance == USART2)
+  {
+    UartTx_OnTxCplt();
+  }
+  else if (huart->Instance == USART1)
+  {
+    Log_OnTxCplt();
+  }
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  if (GPIO_Pin == GPIO_PIN_3)
+  {
+    // USART2 RX start bit while parked
+    Power_OnWakeEdge();
+  }
+  else
+  {
+    Encoder_OnEdge(GPIO_Pin);
+  }
+}
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+  if (htim->Instance == TIM10)
+  {
+#if UART_CAR_RTOS
+    RtosApp_OnTick();
+#else
+    Exec_Tick();
+#endif
+  }
+#if UART_CAR_RTOS
+  else if (htim->Instance == TIM11)
+  {
+    // HAL time base while SysTick is the kernel tick
+    HAL_IncTick();
+    Log_Flush();
+  }
+#endif
+}
+
+/* ---------- Tasks ---------- */
+
+#if POWER_STOP_ENABLE
+static uint32_t lastFrameTick = 0; // HAL tick of the last intact frame
+#endif
+
+// Position loop on a fresh encoder sample (1 kHz, tick)
+static void Task_Steer(void)
+{
+  Encoder_Update();
+  Motor_Angle_ControlTick();
+}
+
+// Timers, link supervision and the PWM output stage (1 kHz, tick)
+static void Task_Outputs(void)
+{
+  SoftTimer_Tick();
+  Deadman_Tick();
+  PwmOut_Tick();
+}
+
+// Drain everything the ISR queued since the last run (1 kHz, loop)
+static void Task_Commands(void)
+{
+  const uint8_t *frame;
+  uint8_t frameLen;
+  while ((frame = FrameQueue_Peek(&frameLen)) != NULL)
+  {
+    // Fields are read in place from the queue slot, released once handled
+    PacketView packet;
+    uint8_t result = PacketCodec_Decode(frame, frameLen, &packet);
+    if (result == 0)
     {
-      // Second byte received. Check if it's the second part of the start (0xAA)
-      if (rxBuffer[1] != 0xAA)
-      {
-        // Not the correct second start byte, reset index and prepare to receive the first byte again
-        rxIndex = 0;
-        HAL_UART_Receive_IT(&huart2, &rxBuffer[0], 1); // Restart reception for the first byte
-        return;                                        // Exit callback
-      }
+      Deadman_Feed(); // any intact frame shows the host is alive
+#if POWER_STOP_ENABLE
+      lastFrameTick = HAL_GetTick();
+#endif
+      Link_Receive(packet.seq); // reports the seqs skipped over as missing
     }
-    // Increment index for the next byte
-    rxIndex++;
-
-    // If a full packet is received
-    if (rxIndex >= sizeof(struct Packet))
+    if (result == 0 && Link_Check(packet.seq) == LINK_DUPLICATE)
     {
-      packetReceivedFlag = 1; // Signal main loop
-      rxIndex = 0;            // Reset for the next packet
-                              // Do NOT restart reception here, main loop will process and then restart
+      // Retransmission of a command already run, confirm without running it again
+      result = CONFIRM_DUPLICATE;
     }
-    else
+    else if (result == 0)
     {
-      // Continue receiving the next byte into the next position
-      HAL_UART_Receive_IT(&huart2, &rxBuffer[rxIndex], 1);
+      result = SerializePacket(&packet);
+      if (result == 0)
+        Link_Record(packet.seq); // only executed frames count as duplicates
     }
+    // On a rejected frame seq/ID are best effort, the host retransmits whatever it matches
+    Link_Respond(&packet, result);
+    FrameQueue_Release();
   }
 }
 
-void uart2_send_bytes(uint8_t *data, uint16_t size)
+#if UART_CAR_RTOS
+// Control thread body: the speed loops run on every WHEEL_CONTROL_DIVIDER-th release
+static void Task_Control(void)
+{
+  static uint8_t speedDivider = 0;
+
+  Task_Steer();
+  if (++speedDivider >= WHEEL_CONTROL_DIVIDER)
+  {
+    speedDivider = 0;
+    Motor_SpeedControlTick();
+  }
+}
+
+// See RtosApp.h for the threads running them
+static const RtosAppTasks rtosTasks = {
+  .control = Task_Control,
+  .actuators = Task_Outputs,
+  .commands = Task_Commands,
+  .housekeeping = Motor_Angle_Process,
+};
+#else
+// Vehicle state on the debug log (50 Hz, loop)
+static void Task_Telemetry(void)
+{
+  LOG(TELEMETRY,
+      (int32_t)Encoder_GetPosition(ENCODER_STEER),
+      Motor_Angle_AtTarget(),
+      (int32_t)Motor_GetRpm(1),
+      (int32_t)Motor_GetRpm(2),
+      Deadman_IsTripped());
+}
+
+static void Task_Housekeeping(void);
+
+// Highest priority first (rate monotonic), see Exec.h
+static const ExecTask tasks[] = {
+  {Task_Steer, 1, EXEC_IN_TICK},
+  {Task_Outputs, 1, EXEC_IN_TICK},
+  {Motor_SpeedControlTick, WHEEL_CONTROL_DIVIDER, EXEC_IN_TICK},
+  {Task_Commands, 1, EXEC_IN_LOOP},
+  {Task_Telemetry, EXEC_TICK_HZ / 50U, EXEC_IN_LOOP},
+  {Task_Housekeeping, EXEC_TICK_HZ / 10U, EXEC_IN_LOOP},
+};
+#define TASK_COUNT (sizeof(tasks) / sizeof(tasks[0]))
+
+#if POWER_STOP_ENABLE
+static uint8_t parkRequested = 0; // set by Task_Housekeeping, parked by the main loop
+
+// No frame for POWER_PARK_MS: all outputs off, wait in Stop mode for the host.
+// Runs from the main loop between tasks, so the stay is no task's run time
+static void Park(void)
 {
-  HAL_UART_Transmit(&huart2, data, size, HAL_MAX_DELAY);
+  parkRequested = 0;
+  LOG(POWER_PARK, (int32_t)((HAL_GetTick() - lastFrameTick) / 1000U));
+  Motor_Angle_Stop();
+  HAL_Delay(2); // the zero compare is preloaded, applied at the next PWM update
+
+  // No releases while parked, the tasks start over on the first tick after waking
+  HAL_TIM_Base_Stop_IT(&htim10);
+  Power_EnterStop();
+  SystemClock_Config(); // Stop mode always wakes up on HSI
+  Exec_Restart();
+  HAL_TIM_Base_Start_IT(&htim10);
+
+  LOG(POWER_WAKE);
+  // The encoders were not clocked, the steering may have been turned by hand
+  Motor_Angle_Rehome();
+  lastFrameTick = HAL_GetTick();
 }
+#endif
 
-/* volatile-safe copy helper */
-static inline void memcpy_from_volatile(void *dst, const volatile void *src, size_t n)
+// CPU load over the last second, from the time Power_Idle slept
+static void ReportLoad(void)
 {
-  uint8_t *d = (uint8_t *)dst;
-  const volatile uint8_t *s = (const volatile uint8_t *)src;
-  for (size_t i = 0; i < n; ++i)
-    d[i] = s[i];
+  static uint32_t startTick = 0;
+  static uint32_t startIdleUs = 0;
+
+  uint32_t now = HAL_GetTick();
+  uint32_t idleNow = Power_GetIdleUs();
+  uint32_t elapsedUs = (now - startTick) * 1000U;
+  uint32_t idleUs = idleNow - startIdleUs;
+  startTick = now;
+  startIdleUs = idleNow;
+
+  if (elapsedUs == 0)
+    return;
+  if (idleUs > elapsedUs)
+    idleUs = elapsedUs;
+  LOG(CPU_LOAD, (int32_t)(1000U - (uint32_t)((uint64_t)idleUs * 1000U / elapsedUs)), (int32_t)idleUs);
+}
+
+// Calibration saves, deadline miss reports, CPU load, park requests (10 Hz, loop)
+static void Task_Housekeeping(void)
+{
+  static uint32_t reportedMisses[TASK_COUNT];
+  static uint8_t loadDivider = 0;
+
+  Motor_Angle_Process();
+
+  if (++loadDivider >= 10U)
+  {
+    loadDivider = 0;
+    ReportLoad();
+  }
+
+  for (uint8_t i = 0; i < TASK_COUNT; i++)
+  {
+    ExecTaskStats stats;
+    Exec_GetStats(i, &stats);
+    if (stats.misses != reportedMisses[i])
+    {
+      reportedMisses[i] = stats.misses;
+      LOG(EXEC_MISS, i, stats.misses, stats.maxCycles);
+    }
+  }
+
+#if POWER_STOP_ENABLE
+  if (HAL_GetTick() - lastFrameTick >= POWER_PARK_MS && Motor_IsStopped() && Motor_Angle_IsCalibrated())
+    parkRequested = 1;
+#endif
 }
+#endif /* UART_CAR_RTOS */
 
 /* USER CODE END 0 */
 
@@ -174,28 +389,48 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_USART2_UART_Init();
   MX_USART1_UART_Init();
   MX_TIM3_Init();
   MX_TIM4_Init();
   MX_TIM2_Init();
   MX_TIM5_Init();
+  MX_TIM10_Init();
   /* USER CODE BEGIN 2 */
 
 
-
-  // Start the first UART receive IT
-  // The first byte will be placed at rxBuffer[0]
-  Encoder_Init(&htim3);
+  // Records are kept in RAM and drained by DMA from here on
+  Log_Init(&huart1);
+  Power_Init();
+  CycleCounter_Init();
+  Encoder_Init();
+  PwmOut_Init();
   Motor_Init_Angle();
   Horn_Init();
   Light_Init();
+  SoftTimer_Init();
   Motor_init();
+  Deadman_Init();
   
-    // Initialize uart_log_printf with huart2
-  uart_log_init(&huart2);
-  uart_log_printf("STM32 Ready for Packets...\r\n");
-  HAL_UART_Receive_IT(&huart2, &rxBuffer[0], 1);
+  LOG(BOOT);
+#if BENCH_ENABLE
+  // Before the tick starts, so only the log DMA interrupts can disturb it
+  Bench_Packet();
+#endif
+  // Reception runs continuously from here on (DMA or IT, see UART_RX_MODE)
+  FrameQueue_Init();
+  UartTx_Init(&huart2);
+  Link_Init();
+  UartRx_Init(&huart2);
+#if UART_CAR_RTOS
+  // Threads take over from here, the kernel never returns
+  RtosApp_Start(&rtosTasks);
+#else
+  // Tasks are released by the TIM10 update interrupt from here on
+  Exec_Init(tasks, TASK_COUNT);
+  HAL_TIM_Base_Start_IT(&htim10);
+#endif
 
   /* USER CODE END 2 */
 
@@ -213,8 +448,6 @@ int main(void)
     // Light_Front_On();
     // HAL_Delay(500); // 500 ms light on
 
-    // Horn_Toggle();
-
         //     HAL_GPIO_WritePin(GPIOB, GPIO_PIN_4, GPIO_PIN_SET); // DIR = Forward
         // __HAL_TIM_SET_COMPARE(&htim4, TIM_CHANNEL_3, 2100); // ~50% duty if ARR=4199
 
@@ -229,42 +462,19 @@ int main(void)
     // __HAL_TIM_SET_COMPARE(&htim4, TIM_CHANNEL_3, arr / 2);
 
 
-    if (packetReceivedFlag)
+    // Loop tasks run as the tick releases them, highest priority first;
+    // with nothing ready the core sleeps until the next interrupt, or parks
+    if (!Exec_RunLoop())
     {
-      packetReceivedFlag = 0;
-      struct Packet receivedPacket;
-      memcpy_from_volatile(&receivedPacket, rxBuffer, sizeof(struct Packet));
-      uint8_t result = SerializePacket(&receivedPacket);
-      switch (result)
+#if POWER_STOP_ENABLE && !UART_CAR_RTOS
+      if (parkRequested)
       {
-      case 0:
-        uart2_send_bytes((uint8_t *)"Packet OK\r\n", strlen("Packet OK\r\n"));
-        for (int i = 0; i < 4; i++)
-        {
-          char buf[8];
-          int n = snprintf(buf, sizeof(buf), "%02X\r\n", receivedPacket.payload[i]);
-          uart2_send_bytes((uint8_t *)buf, (uint16_t)n);
-        }
-
-        break;
-      case 1:
-        uart2_send_bytes((uint8_t *)"Invalid start or end packet values\r\n", strlen("Invalid..."));
-        break;
-      case 2:
-        uart2_send_bytes((uint8_t *)"Checksum mismatch\r\n", strlen("Checksum mismatch\r\n"));
-        break;
-      case 3:
-        uart2_send_bytes((uint8_t *)"Unknown packet ID\r\n", strlen("Unknown packet ID\r\n"));
-        break;
-      default:
-        uart2_send_bytes((uint8_t *)"Bad Packet\r\n", strlen("Bad Packet\r\n"));
-        break;
+        Park();
+        continue;
       }
-      // After processing, restart reception for the next packet's first byte
-      HAL_UART_Receive_IT(&huart2, &rxBuffer[0], 1);
+#endif
+      Power_Idle();
     }
-    // Encoder_ReadData(&htim3, 1);
-    HAL_Delay(1);
   }
   /* USER CODE END 3 */
 }
@@ -289,7 +499,17 @@ void SystemClock_Config(void)
   RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
   RCC_OscInitStruct.HSIState = RCC_HSI_ON;
   RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+#if CLOCK_PROFILE == CLOCK_PROFILE_PLL84
+  // 16 MHz / M 16 = 1 MHz, * N 336 = 336 MHz VCO, / P 4 = 84 MHz, / Q 7 = 48 MHz
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+  RCC_OscInitStruct.PLL.PLLM = 16;
+  RCC_OscInitStruct.PLL.PLLN = 336;
+  RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
+  RCC_OscInitStruct.PLL.PLLQ = 7;
+#else
   RCC_OscInitStruct.PLL.PLLState = RCC_PLL_NONE;
+#endif
   if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
   {
     Error_Handler();
@@ -299,12 +519,19 @@ void SystemClock_Config(void)
   */
   RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
                               |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
+#if CLOCK_PROFILE == CLOCK_PROFILE_PLL84
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2; // APB1 is limited to 42 MHz
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+#else
   RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
   RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
   RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
   RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+#endif
 
-  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_0) != HAL_OK)
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, CLOCK_FLASH_LATENCY) != HAL_OK)
   {
     Error_Handler();
   }
@@ -334,7 +561,7 @@ static void MX_TIM2_Init(void)
   htim2.Init.Period = 4294967295;
   htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
   htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
-  sConfig.EncoderMode = TIM_ENCODERMODE_TI1;
+  sConfig.EncoderMode = TIM_ENCODERMODE_TI12;
   sConfig.IC1Polarity = TIM_ICPOLARITY_RISING;
   sConfig.IC1Selection = TIM_ICSELECTION_DIRECTTI;
   sConfig.IC1Prescaler = TIM_ICPSC_DIV1;
@@ -383,7 +610,7 @@ static void MX_TIM3_Init(void)
   htim3.Init.Period = 65535;
   htim3.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
   htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
-  sConfig.EncoderMode = TIM_ENCODERMODE_TI1;
+  sConfig.EncoderMode = TIM_ENCODERMODE_TI12;
   sConfig.IC1Polarity = TIM_ICPOLARITY_RISING;
   sConfig.IC1Selection = TIM_ICSELECTION_DIRECTTI;
   sConfig.IC1Prescaler = TIM_ICPSC_DIV1;
@@ -431,7 +658,7 @@ static void MX_TIM4_Init(void)
   htim4.Init.CounterMode = TIM_COUNTERMODE_UP;
   htim4.Init.Period = 65535;
   htim4.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
-  htim4.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  htim4.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
   if (HAL_TIM_PWM_Init(&htim4) != HAL_OK)
   {
     Error_Handler();
@@ -489,7 +716,7 @@ static void MX_TIM5_Init(void)
   htim5.Init.Period = 4294967295;
   htim5.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
   htim5.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
-  sConfig.EncoderMode = TIM_ENCODERMODE_TI1;
+  sConfig.EncoderMode = TIM_ENCODERMODE_TI12;
   sConfig.IC1Polarity = TIM_ICPOLARITY_RISING;
   sConfig.IC1Selection = TIM_ICSELECTION_DIRECTTI;
   sConfig.IC1Prescaler = TIM_ICPSC_DIV1;
@@ -514,6 +741,37 @@ static void MX_TIM5_Init(void)
 
 }
 
+/**
+  * @brief TIM10 Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_TIM10_Init(void)
+{
+
+  /* USER CODE BEGIN TIM10_Init 0 */
+
+  /* USER CODE END TIM10_Init 0 */
+
+  /* USER CODE BEGIN TIM10_Init 1 */
+  // Control tick: 1 MHz counter (Power_Idle times sleep in its counts) / 1000 = 1 kHz
+  /* USER CODE END TIM10_Init 1 */
+  htim10.Instance = TIM10;
+  htim10.Init.Prescaler = CLOCK_TIMER_HZ / 1000000U - 1U;
+  htim10.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim10.Init.Period = 999;
+  htim10.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim10.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+  if (HAL_TIM_Base_Init(&htim10) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* USER CODE BEGIN TIM10_Init 2 */
+
+  /* USER CODE END TIM10_Init 2 */
+
+}
+
 /**
   * @brief USART1 Initialization Function
   * @param None
@@ -580,6 +838,29 @@ static void MX_USART2_UART_Init(void)
 
 }
 
+/**
+  * Enable DMA controller clock
+  */
+static void MX_DMA_Init(void)
+{
+
+  /* DMA controller clock enable */
+  __HAL_RCC_DMA2_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  /* DMA interrupt init */
+  /* DMA1_Stream5_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Stream5_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+  /* DMA1_Stream6_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Stream6_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+  /* DMA2_Stream7_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA2_Stream7_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream7_IRQn);
+
+}
+
 /**
   * @brief GPIO Initialization Function
   * @param None
@@ -0,0 +1,53 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/*
+ * Helpers shared by the host tests. Each test is one program: CHECK
+ * reports a failed condition and counts it, main returns TEST_RESULT().
+ * Random data comes from a seeded xorshift generator so every run feeds
+ * the same bytes.
+ */
+
+static int testFailures = 0;
+
+#define CHECK(cond)                                                        \
+    do                                                                     \
+    {                                                                      \
+        if (!(cond))                                                       \
+        {                                                                  \
+            printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            testFailures++;                                                \
+        }                                                                  \
+    } while (0)
+
+#define TEST_RESULT() (testFailures == 0 ? 0 : 1)
+
+/* Seed must be non-zero */
+static inline uint32_t Test_Random(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+/* Uniform in [0, n) */
+static inline uint32_t Test_RandomBelow(uint32_t *state, uint32_t n)
+{
+    return Test_Random(state) % n;
+}
+
+/* Monotonic wall time in seconds, for the benchmarks */
+static inline double Test_Seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#endif // TEST_H
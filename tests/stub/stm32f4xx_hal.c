@@ -0,0 +1,7 @@
+#include "stm32f4xx_hal.h"
+
+GPIO_TypeDef hostGpioB;
+DWT_Type hostDwt;
+CoreDebug_Type hostCoreDebug;
+uint32_t hostPrimask;
+uint32_t SystemCoreClock = 16000000U;
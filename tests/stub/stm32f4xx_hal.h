@@ -0,0 +1,51 @@
+#ifndef STM32F4XX_HAL_H
+#define STM32F4XX_HAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Host stand-in for the parts of the HAL and CMSIS that the module
+ * headers under test name. Only types, pin macros and core registers;
+ * peripherals do nothing here, a test stubs the driver functions it
+ * reaches instead.
+ */
+
+typedef struct { uint32_t ODR; } GPIO_TypeDef;
+typedef struct { void *Instance; } TIM_HandleTypeDef;
+typedef struct { void *Instance; void *hdmarx; uint32_t RxState; } UART_HandleTypeDef;
+
+typedef enum { HAL_OK = 0, HAL_ERROR, HAL_BUSY, HAL_TIMEOUT } HAL_StatusTypeDef;
+
+extern GPIO_TypeDef hostGpioB;
+#define GPIOB (&hostGpioB)
+
+#define GPIO_PIN_0  ((uint16_t)0x0001)
+#define GPIO_PIN_1  ((uint16_t)0x0002)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+#define GPIO_PIN_12 ((uint16_t)0x1000)
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+
+/* Core registers: no debug unit on the host, the cycle counter stays 0
+   unless a test advances hostDwt.CYCCNT */
+typedef struct { volatile uint32_t CTRL; volatile uint32_t CYCCNT; } DWT_Type;
+typedef struct { volatile uint32_t DEMCR; } CoreDebug_Type;
+
+extern DWT_Type hostDwt;
+extern CoreDebug_Type hostCoreDebug;
+#define DWT       (&hostDwt)
+#define CoreDebug (&hostCoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk         (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk     (1UL << 24)
+
+/* Core clock, as system_stm32f4xx.c keeps it */
+extern uint32_t SystemCoreClock;
+
+/* Interrupt masking: a single thread on the host, PRIMASK is just a flag */
+extern uint32_t hostPrimask;
+static inline uint32_t __get_PRIMASK(void) { return hostPrimask; }
+static inline void __set_PRIMASK(uint32_t primask) { hostPrimask = primask; }
+static inline void __disable_irq(void) { hostPrimask = 1; }
+static inline void __enable_irq(void) { hostPrimask = 0; }
+
+#endif // STM32F4XX_HAL_H
@@ -0,0 +1,125 @@
+#include "Test.h"
+#include "Exec.h"
+#include "stm32f4xx_hal.h"
+
+/*
+ * Exec test: tasks are released at their rates, a loop task that runs
+ * late or overruns its period counts a miss, and a pause of the tick
+ * (parking in Stop mode) ended by Exec_Restart counts none. Time is the
+ * stub DWT cycle counter, advanced by hand: CYCLES_PER_TICK per tick and
+ * whatever a task "spends" while it runs.
+ */
+
+#define CYCLES_PER_TICK (16000000U / EXEC_TICK_HZ)
+
+static uint32_t tickRuns;
+static uint32_t fastRuns;
+static uint32_t slowRuns;
+static uint32_t slowCost; // cycles the slow task spends per run
+
+static void TickTask(void) { tickRuns++; }
+static void FastTask(void) { fastRuns++; }
+static void SlowTask(void)
+{
+    slowRuns++;
+    hostDwt.CYCCNT += slowCost;
+}
+
+static const ExecTask tasks[] = {
+    {TickTask, 1, EXEC_IN_TICK},
+    {FastTask, 1, EXEC_IN_LOOP},
+    {SlowTask, 10, EXEC_IN_LOOP},
+};
+#define TASK_COUNT (sizeof(tasks) / sizeof(tasks[0]))
+
+static void Reset(void)
+{
+    hostDwt.CYCCNT = 0;
+    tickRuns = fastRuns = slowRuns = 0;
+    slowCost = 0;
+    Exec_Init(tasks, TASK_COUNT);
+}
+
+// One tick, then the main loop runs whatever was released
+static void Tick(void)
+{
+    Exec_Tick();
+    while (Exec_RunLoop())
+        ;
+    hostDwt.CYCCNT += CYCLES_PER_TICK;
+}
+
+static uint32_t Misses(uint8_t task)
+{
+    ExecTaskStats stats;
+    Exec_GetStats(task, &stats);
+    return stats.misses;
+}
+
+static void Test_Rates(void)
+{
+    Reset();
+    for (uint32_t i = 0; i < 100U; i++)
+        Tick();
+    CHECK(tickRuns == 100 && fastRuns == 100 && slowRuns == 10);
+    CHECK(Misses(0) == 0 && Misses(1) == 0 && Misses(2) == 0);
+    CHECK(!Exec_HasPending());
+}
+
+static void Test_Misses(void)
+{
+    ExecTaskStats stats;
+
+    // Main loop blocked for 3 ticks: the fast task misses 2 releases
+    Reset();
+    Tick();
+    for (uint32_t i = 0; i < 3U; i++)
+    {
+        Exec_Tick();
+        hostDwt.CYCCNT += CYCLES_PER_TICK;
+    }
+    CHECK(Exec_HasPending());
+    Tick();
+    CHECK(Misses(1) >= 2);
+
+    // An overrun of the slow task's period is a miss too
+    Reset();
+    slowCost = 11U * CYCLES_PER_TICK;
+    Tick();
+    CHECK(Misses(2) == 1);
+    Exec_GetStats(2, &stats);
+    CHECK(stats.runs == 1 && stats.maxCycles == slowCost);
+}
+
+static void Test_Restart(void)
+{
+    Reset();
+    for (uint32_t i = 0; i < 25U; i++)
+        Tick();
+
+    // Parked with a release still pending, as when the tick stopped mid-period:
+    // a minute without ticks, then the tasks start over
+    Exec_Tick();
+    CHECK(Exec_HasPending());
+    hostDwt.CYCCNT += 60000U * CYCLES_PER_TICK;
+    Exec_Restart();
+    CHECK(!Exec_HasPending());
+
+    uint32_t slowBefore = slowRuns;
+    for (uint32_t i = 0; i < 30U; i++)
+        Tick();
+    CHECK(Misses(0) == 0 && Misses(1) == 0 && Misses(2) == 0);
+    CHECK(slowRuns - slowBefore == 3); // released on the first tick, then every 10
+
+    ExecTaskStats stats;
+    Exec_GetStats(1, &stats);
+    CHECK(stats.runs == 25 + 30 && stats.maxCycles == 0); // stats kept, the pause is no run time
+}
+
+int main(void)
+{
+    Test_Rates();
+    Test_Misses();
+    Test_Restart();
+    return TEST_RESULT();
+}
@@ -0,0 +1,285 @@
+#include "Test.h"
+#include "FrameParser.h"
+#include "PacketCodec.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * FrameParser fuzz test and benchmark.
+ *
+ * Streams of PacketCodec frames, each tagged with its index in the first
+ * two payload bytes, are fed in random-sized chunks (DMA bursts):
+ * - clean: every frame comes out, no errors
+ * - noise: random bytes never produce a frame with bad markers or length
+ * - corrupted: bytes flipped, dropped and inserted, noise bursts between
+ *   frames; every frame not hit keeps coming out, at most one neighbour
+ *   is lost per corruption
+ * and the throughput (bytes/s) and resync latency (bytes from an error to
+ * the next good frame) are printed.
+ */
+
+#define FRAME_COUNT     20000U
+#define CORRUPT_PERCENT 10U
+#define NOISE_BYTES     (1U << 20)
+#define BENCH_SECONDS   0.2
+
+typedef enum
+{
+    CORRUPT_NONE = 0,
+    CORRUPT_FLIP,   // one byte changed
+    CORRUPT_DROP,   // one byte missing
+    CORRUPT_INSERT, // one random byte added inside the frame
+    CORRUPT_NOISE,  // 1..16 random bytes before the frame, frame intact
+    CORRUPT_KINDS
+} Corruption;
+
+typedef struct
+{
+    uint8_t *bytes;
+    uint32_t len;
+    uint8_t *hit; // per frame: 1 if its own bytes were corrupted
+    uint32_t corruptions;
+} Stream;
+
+// What the parser delivered, filled by OnFrame
+static FrameParser parser;
+static uint16_t *delivered;   // per frame index: times it came out intact
+static uint32_t intactFrames;
+static uint32_t crcFailures;  // markers and length fine, CRC not (corrupted payload)
+static uint32_t badShape;     // markers or length wrong: must never happen
+static uint32_t lastErrors;
+static uint64_t resyncTotal;
+static uint32_t resyncCount;
+
+static void OnFrame(const uint8_t *frame, uint16_t len)
+{
+    PacketView view;
+    uint8_t result = PacketCodec_Decode(frame, len, &view);
+
+    if (result == 1)
+        badShape++;
+    else if (result == 2)
+        crcFailures++;
+    else if (view.len >= 2)
+    {
+        uint16_t index = PacketCodec_GetU16(view.payload);
+        if (index < FRAME_COUNT)
+            delivered[index]++;
+        intactFrames++;
+    }
+
+    // First frame after one or more errors: the parser just measured a resync
+    if (parser.stats.errors != lastErrors)
+    {
+        lastErrors = parser.stats.errors;
+        resyncTotal += parser.stats.resyncBytes;
+        resyncCount++;
+    }
+}
+
+static const FrameParserConfig config = {
+    .startMarker = PACKET_START_MARKER,
+    .endMarker = PACKET_END_MARKER,
+    .headerLen = PACKET_HEADER_SIZE,
+    .lengthOf = PacketCodec_FrameLength,
+    .onFrame = OnFrame,
+};
+
+static void Reset(void)
+{
+    FrameParser_Init(&parser, &config);
+    memset(delivered, 0, FRAME_COUNT * sizeof(delivered[0]));
+    intactFrames = 0;
+    crcFailures = 0;
+    badShape = 0;
+    lastErrors = 0;
+    resyncTotal = 0;
+    resyncCount = 0;
+}
+
+static void PushChunked(const uint8_t *data, uint32_t len, uint32_t *rng)
+{
+    uint32_t offset = 0;
+    while (offset < len)
+    {
+        uint32_t chunk = 1U + Test_RandomBelow(rng, 64);
+        if (chunk > len - offset)
+            chunk = len - offset;
+        FrameParser_Push(&parser, data + offset, (uint16_t)chunk);
+        offset += chunk;
+    }
+}
+
+static void BuildStream(Stream *s, uint32_t seed, uint8_t corrupt)
+{
+    uint32_t rng = seed;
+    s->bytes = malloc((size_t)FRAME_COUNT * (PACKET_MAX_FRAME_SIZE + 16U));
+    s->hit = calloc(FRAME_COUNT, 1);
+    s->len = 0;
+    s->corruptions = 0;
+
+    for (uint32_t i = 0; i < FRAME_COUNT; i++)
+    {
+        uint8_t payload[PACKET_MAX_PAYLOAD];
+        uint8_t len = (uint8_t)(2U + Test_RandomBelow(&rng, PACKET_MAX_PAYLOAD - 1U));
+        PacketCodec_PutU16(payload, (uint16_t)i);
+        for (uint8_t b = 2; b < len; b++)
+            payload[b] = (uint8_t)Test_Random(&rng);
+
+        uint8_t frame[PACKET_MAX_FRAME_SIZE + 1];
+        uint16_t frameLen = PacketCodec_Encode(frame, (uint8_t)i, (uint8_t)(1U + i % 10U), payload, len);
+
+        Corruption kind = CORRUPT_NONE;
+        if (corrupt && Test_RandomBelow(&rng, 100) < CORRUPT_PERCENT)
+            kind = (Corruption)(1U + Test_RandomBelow(&rng, CORRUPT_KINDS - 1U));
+
+        uint16_t at = (uint16_t)Test_RandomBelow(&rng, frameLen);
+        switch (kind)
+        {
+        case CORRUPT_FLIP:
+            frame[at] ^= (uint8_t)(1U + Test_RandomBelow(&rng, 255));
+            break;
+        case CORRUPT_DROP:
+            memmove(frame + at, frame + at + 1, frameLen - at - 1U);
+            frameLen--;
+            break;
+        case CORRUPT_INSERT:
+            memmove(frame + at + 1, frame + at, frameLen - at);
+            frame[at] = (uint8_t)Test_Random(&rng);
+            frameLen++;
+            break;
+        case CORRUPT_NOISE:
+        {
+            uint32_t noise = 1U + Test_RandomBelow(&rng, 16);
+            for (uint32_t b = 0; b < noise; b++)
+                s->bytes[s->len++] = (uint8_t)Test_Random(&rng);
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (kind != CORRUPT_NONE)
+            s->corruptions++;
+        s->hit[i] = (kind != CORRUPT_NONE && kind != CORRUPT_NOISE);
+        memcpy(s->bytes + s->len, frame, frameLen);
+        s->len += frameLen;
+    }
+}
+
+static void FreeStream(Stream *s)
+{
+    free(s->bytes);
+    free(s->hit);
+}
+
+// Bytes per second over repeated passes of the whole stream
+static double Throughput(const Stream *s)
+{
+    uint32_t passes = 0;
+    double start = Test_Seconds();
+    double elapsed;
+    do
+    {
+        FrameParser_Init(&parser, &config);
+        for (uint32_t offset = 0; offset < s->len; offset += UINT16_MAX)
+        {
+            uint32_t chunk = s->len - offset < UINT16_MAX ? s->len - offset : UINT16_MAX;
+            FrameParser_Push(&parser, s->bytes + offset, (uint16_t)chunk);
+        }
+        passes++;
+        elapsed = Test_Seconds() - start;
+    } while (elapsed < BENCH_SECONDS);
+
+    return (double)s->len * passes / elapsed;
+}
+
+static void Test_Clean(void)
+{
+    Stream s;
+    uint32_t rng = 0x1234567U;
+    BuildStream(&s, 0xC0FFEEU, 0);
+    Reset();
+    PushChunked(s.bytes, s.len, &rng);
+
+    CHECK(parser.stats.bytes == s.len);
+    CHECK(parser.stats.frames == FRAME_COUNT);
+    CHECK(parser.stats.errors == 0);
+    CHECK(parser.stats.discarded == 0);
+    CHECK(intactFrames == FRAME_COUNT);
+    CHECK(badShape == 0 && crcFailures == 0);
+    uint32_t once = 0;
+    for (uint32_t i = 0; i < FRAME_COUNT; i++)
+        once += (delivered[i] == 1);
+    CHECK(once == FRAME_COUNT);
+
+    double bytesPerSec = Throughput(&s);
+    printf("clean:     %u frames, %u bytes, %.1f MB/s, %.2f Mframes/s\n",
+           FRAME_COUNT, s.len, bytesPerSec / 1e6, bytesPerSec / s.len * FRAME_COUNT / 1e6);
+    FreeStream(&s);
+}
+
+static void Test_Noise(void)
+{
+    uint32_t rng = 0xBADC0DEU;
+    uint8_t *noise = malloc(NOISE_BYTES);
+    for (uint32_t i = 0; i < NOISE_BYTES; i++)
+        noise[i] = (uint8_t)Test_Random(&rng);
+
+    Reset();
+    PushChunked(noise, NOISE_BYTES, &rng);
+
+    CHECK(parser.stats.bytes == NOISE_BYTES);
+    CHECK(badShape == 0);
+    CHECK(parser.count < FRAME_PARSER_MAX_LEN);
+    printf("noise:     %u bytes, %u shaped like frames (%u with a good CRC)\n",
+           NOISE_BYTES, parser.stats.frames, intactFrames);
+    free(noise);
+}
+
+static void Test_Corrupted(void)
+{
+    Stream s;
+    uint32_t rng = 0x7654321U;
+    BuildStream(&s, 0xFEEDU, 1);
+    Reset();
+    PushChunked(s.bytes, s.len, &rng);
+
+    uint32_t intactSent = 0;
+    uint32_t intactLost = 0;
+    uint32_t duplicated = 0;
+    for (uint32_t i = 0; i < FRAME_COUNT; i++)
+    {
+        duplicated += (delivered[i] > 1);
+        if (s.hit[i])
+            continue;
+        intactSent++;
+        intactLost += (delivered[i] == 0);
+    }
+
+    CHECK(parser.stats.bytes == s.len);
+    CHECK(badShape == 0);
+    CHECK(duplicated == 0);
+    CHECK(intactLost <= s.corruptions);
+    CHECK(resyncCount > 0);
+
+    printf("corrupted: %u corruptions, %u/%u intact frames out, %u with a bad CRC passed on\n",
+           s.corruptions, intactSent - intactLost, intactSent, crcFailures);
+    printf("resync:    %.1f bytes average, %u bytes max after an error (%u resyncs)\n",
+           resyncCount ? (double)resyncTotal / resyncCount : 0.0,
+           parser.stats.maxResyncBytes, resyncCount);
+    printf("corrupted: %.1f MB/s\n", Throughput(&s) / 1e6);
+    FreeStream(&s);
+}
+
+int main(void)
+{
+    delivered = malloc(FRAME_COUNT * sizeof(delivered[0]));
+
+    Test_Clean();
+    Test_Noise();
+    Test_Corrupted();
+
+    free(delivered);
+    return TEST_RESULT();
+}
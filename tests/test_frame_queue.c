@@ -0,0 +1,145 @@
+#include "Test.h"
+#include "FrameQueue.h"
+#include <string.h>
+
+/*
+ * FrameQueue test: frames come out in order and intact, a full queue
+ * drops and counts new frames, oversized frames are refused, and the
+ * free-running indexes keep working across many laps of the slots.
+ */
+
+static void Fill(uint8_t *frame, uint8_t len, uint8_t tag)
+{
+    for (uint8_t i = 0; i < len; i++)
+        frame[i] = (uint8_t)(tag + i);
+}
+
+static uint8_t PopMatches(uint8_t len, uint8_t tag)
+{
+    uint8_t expected[FRAME_QUEUE_SLOT_SIZE];
+    uint8_t gotLen = 0;
+    const uint8_t *got = FrameQueue_Peek(&gotLen);
+
+    Fill(expected, len, tag);
+    uint8_t ok = got != NULL && gotLen == len && memcmp(got, expected, len) == 0;
+    FrameQueue_Release();
+    return ok;
+}
+
+static void Test_Order(void)
+{
+    uint8_t frame[FRAME_QUEUE_SLOT_SIZE];
+    uint8_t len;
+    FrameQueueStats stats;
+
+    FrameQueue_Init();
+    CHECK(FrameQueue_Peek(&len) == NULL);
+    FrameQueue_Release(); // empty: no effect
+    FrameQueue_GetStats(&stats);
+    CHECK(stats.depth == 0 && stats.pushed == 0);
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        Fill(frame, (uint8_t)(10 + i), i);
+        CHECK(FrameQueue_Push(frame, (uint8_t)(10 + i)) == 1);
+    }
+    // Peek leaves the frame in place
+    CHECK(FrameQueue_Peek(&len) != NULL && len == 10);
+    CHECK(FrameQueue_Peek(&len) != NULL && len == 10);
+    for (uint8_t i = 0; i < 3; i++)
+        CHECK(PopMatches((uint8_t)(10 + i), i));
+    CHECK(FrameQueue_Peek(&len) == NULL);
+
+    FrameQueue_GetStats(&stats);
+    CHECK(stats.depth == 0 && stats.pushed == 3 && stats.highWater == 3 && stats.overflows == 0);
+}
+
+static void Test_Full(void)
+{
+    uint8_t frame[FRAME_QUEUE_SLOT_SIZE + 1];
+    FrameQueueStats stats;
+
+    FrameQueue_Init();
+    for (uint8_t i = 0; i < FRAME_QUEUE_DEPTH; i++)
+    {
+        Fill(frame, 9, i);
+        CHECK(FrameQueue_Push(frame, 9) == 1);
+    }
+    Fill(frame, 9, 0xEE);
+    CHECK(FrameQueue_Push(frame, 9) == 0);
+
+    FrameQueue_GetStats(&stats);
+    CHECK(stats.depth == FRAME_QUEUE_DEPTH && stats.highWater == FRAME_QUEUE_DEPTH);
+    CHECK(stats.overflows == 1 && stats.pushed == FRAME_QUEUE_DEPTH);
+
+    // The oldest frames survive, the dropped one never shows up
+    CHECK(PopMatches(9, 0));
+    Fill(frame, 9, 0x80);
+    CHECK(FrameQueue_Push(frame, 9) == 1);
+    for (uint8_t i = 1; i < FRAME_QUEUE_DEPTH; i++)
+        CHECK(PopMatches(9, i));
+    CHECK(PopMatches(9, 0x80));
+
+    // Longest frame fits, one byte more is refused
+    Fill(frame, FRAME_QUEUE_SLOT_SIZE, 0x40);
+    CHECK(FrameQueue_Push(frame, FRAME_QUEUE_SLOT_SIZE) == 1);
+    CHECK(FrameQueue_Push(frame, FRAME_QUEUE_SLOT_SIZE + 1) == 0);
+    CHECK(PopMatches(FRAME_QUEUE_SLOT_SIZE, 0x40));
+    FrameQueue_GetStats(&stats);
+    CHECK(stats.overflows == 2);
+}
+
+static void Test_Laps(void)
+{
+    uint32_t rng = 0xF00DU;
+    uint8_t frame[FRAME_QUEUE_SLOT_SIZE];
+    uint32_t pushedTag = 0;
+    uint32_t poppedTag = 0;
+    uint32_t mismatches = 0;
+    uint8_t len;
+
+    FrameQueue_Init();
+    for (uint32_t step = 0; step < 100000U; step++)
+    {
+        // Random bursts on either side, like the ISR and the main loop
+        uint32_t burst = Test_RandomBelow(&rng, FRAME_QUEUE_DEPTH + 2U);
+        if (Test_RandomBelow(&rng, 2) == 0)
+        {
+            while (burst--)
+            {
+                uint8_t frameLen = (uint8_t)(1U + pushedTag % FRAME_QUEUE_SLOT_SIZE);
+                Fill(frame, frameLen, (uint8_t)pushedTag);
+                if (!FrameQueue_Push(frame, frameLen))
+                    break;
+                pushedTag++;
+            }
+        }
+        else
+        {
+            while (burst-- && FrameQueue_Peek(&len) != NULL)
+            {
+                mismatches += !PopMatches((uint8_t)(1U + poppedTag % FRAME_QUEUE_SLOT_SIZE), (uint8_t)poppedTag);
+                poppedTag++;
+            }
+        }
+    }
+    while (FrameQueue_Peek(&len) != NULL)
+    {
+        mismatches += !PopMatches((uint8_t)(1U + poppedTag % FRAME_QUEUE_SLOT_SIZE), (uint8_t)poppedTag);
+        poppedTag++;
+    }
+
+    FrameQueueStats stats;
+    FrameQueue_GetStats(&stats);
+    CHECK(mismatches == 0);
+    CHECK(poppedTag == pushedTag && stats.pushed == pushedTag);
+    CHECK(stats.highWater <= FRAME_QUEUE_DEPTH);
+}
+
+int main(void)
+{
+    Test_Order();
+    Test_Full();
+    Test_Laps();
+    return TEST_RESULT();
+}
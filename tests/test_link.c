@@ -0,0 +1,209 @@
+#include "Test.h"
+#include "Link.h"
+#include "Packet.h"
+#include "UartTx.h"
+#include <string.h>
+
+/*
+ * Link test: drives the sequence tracking the way Task_Commands does and
+ * decodes the confirmations it sends. Every seq gets exactly one answer:
+ * ACK, its NACK reason, DUPLICATE, or MISSING if it never arrived. A
+ * rejected seq is not reported missing later, gaps past LINK_MAX_GAP_NACKS
+ * keep the window, and retransmissions from the old window stay duplicates.
+ */
+
+#define MAX_SENT 64
+
+typedef struct
+{
+    uint8_t seq;      // seq confirmed
+    uint8_t packetID;
+    uint8_t status;
+} Confirmation;
+
+static Confirmation sent[MAX_SENT];
+static uint32_t sentCount;
+static uint32_t outboxFree; // frames the stub outbox still takes
+
+uint8_t UartTx_Send(const uint8_t *data, uint16_t len)
+{
+    PacketView view;
+    if (PacketCodec_Decode(data, len, &view) == 0 && view.packetID == CarConfirmation_ID &&
+        sentCount < MAX_SENT)
+    {
+        sent[sentCount].packetID = view.payload[1];
+        sent[sentCount].status = view.payload[2];
+        sent[sentCount].seq = view.payload[3];
+        sentCount++;
+    }
+    if (outboxFree > 0)
+        outboxFree--;
+    return 1;
+}
+
+uint32_t UartTx_Free(void)
+{
+    return outboxFree;
+}
+
+static void Reset(void)
+{
+    Link_Init();
+    sentCount = 0;
+    outboxFree = 100;
+}
+
+// One intact frame through the link, as Task_Commands: result is what SerializePacket returns
+static void Frame(uint8_t seq, uint8_t packetID, uint8_t result)
+{
+    PacketView packet = {.seq = seq, .packetID = packetID, .len = 0, .payload = NULL};
+
+    Link_Receive(seq);
+    if (Link_Check(seq) == LINK_DUPLICATE)
+        result = CONFIRM_DUPLICATE;
+    else if (result == 0)
+        Link_Record(seq);
+    Link_Respond(&packet, result);
+}
+
+// Answers sent for seq, and the status of the last one
+static uint32_t AnswersFor(uint8_t seq, uint8_t *status)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < sentCount; i++)
+    {
+        if (sent[i].seq != seq)
+            continue;
+        count++;
+        if (status)
+            *status = sent[i].status;
+    }
+    return count;
+}
+
+static void Test_InOrder(void)
+{
+    uint8_t status = 0xFF;
+
+    Reset();
+    for (uint8_t seq = 250; seq != 10; seq++) // across the 8-bit wrap
+        Frame(seq, Motor_ID, 0);
+    CHECK(sentCount == 16);
+    for (uint32_t i = 0; i < sentCount; i++)
+        CHECK(sent[i].status == CONFIRM_ACK && sent[i].packetID == Motor_ID);
+
+    Frame(5, Motor_ID, 0);
+    CHECK(AnswersFor(5, &status) == 2 && status == CONFIRM_DUPLICATE);
+}
+
+static void Test_RejectedThenNext(void)
+{
+    uint8_t status = 0;
+
+    Reset();
+    Frame(10, Motor_ID, 0);
+    Frame(11, Motor_ID, 6);   // bad speed
+    Frame(12, Motor_ID, 0);
+
+    // One answer for the rejected seq, its reason, never MISSING
+    CHECK(AnswersFor(11, &status) == 1 && status == 6);
+    CHECK(AnswersFor(12, &status) == 1 && status == CONFIRM_ACK);
+    CHECK(sentCount == 3);
+
+    // Its retransmission is checked again and runs
+    Frame(11, Motor_ID, 0);
+    CHECK(AnswersFor(11, &status) == 2 && status == CONFIRM_ACK);
+    Frame(11, Motor_ID, 0);
+    CHECK(AnswersFor(11, &status) == 3 && status == CONFIRM_DUPLICATE);
+
+    // Rejected batch and unknown ID behave the same
+    Frame(13, CarBatch_ID, 10);
+    Frame(14, 0x7F, 3);
+    Frame(15, Motor_ID, 0);
+    CHECK(AnswersFor(13, &status) == 1 && status == 10);
+    CHECK(AnswersFor(14, &status) == 1 && status == 3);
+}
+
+static void Test_Gap(void)
+{
+    uint8_t status = 0;
+
+    Reset();
+    Frame(20, Motor_ID, 0);
+    Frame(23, Motor_ID, 0); // 21 and 22 lost
+
+    CHECK(AnswersFor(21, &status) == 1 && status == CONFIRM_MISSING);
+    CHECK(AnswersFor(22, &status) == 1 && status == CONFIRM_MISSING);
+    CHECK(sent[1].packetID == PACKET_ID_NONE);
+    // MISSING reports go out before the answer to the frame that revealed the gap
+    CHECK(sent[3].seq == 23 && sent[3].status == CONFIRM_ACK);
+
+    // Retransmissions fill the gap without new reports
+    Frame(21, Motor_ID, 0);
+    Frame(22, Motor_ID, 0);
+    CHECK(AnswersFor(21, &status) == 2 && status == CONFIRM_ACK);
+    CHECK(AnswersFor(22, &status) == 2 && status == CONFIRM_ACK);
+    CHECK(sentCount == 6);
+}
+
+static void Test_BurstLoss(void)
+{
+    uint8_t status = 0;
+
+    Reset();
+    for (uint8_t seq = 100; seq <= 104; seq++)
+        Frame(seq, Motor_ID, 0);
+    sentCount = 0;
+
+    // 12 frames lost: capped MISSING reports, the window is kept
+    Frame(117, Motor_ID, 0);
+    uint32_t missing = 0;
+    for (uint32_t i = 0; i < sentCount; i++)
+        missing += (sent[i].status == CONFIRM_MISSING);
+    CHECK(missing == 8);
+    CHECK(AnswersFor(105, &status) == 1 && status == CONFIRM_MISSING);
+
+    // A late retransmission from before the burst is still a duplicate
+    Frame(103, Motor_ID, 0);
+    CHECK(AnswersFor(103, &status) == 1 && status == CONFIRM_DUPLICATE);
+
+    // Lost seqs, reported or not, run once when they come
+    Frame(110, Motor_ID, 0);
+    Frame(115, Motor_ID, 0);
+    Frame(115, Motor_ID, 0);
+    CHECK(AnswersFor(110, &status) == 2 && status == CONFIRM_ACK);
+    CHECK(AnswersFor(115, &status) == 2 && status == CONFIRM_DUPLICATE);
+
+    // A full outbox cuts the reports short too
+    Reset();
+    Frame(0, Motor_ID, 0);
+    outboxFree = 3;
+    Frame(5, Motor_ID, 0);
+    CHECK(sentCount == 1 + 2 + 1);
+}
+
+static void Test_Restart(void)
+{
+    uint8_t status = 0;
+
+    Reset();
+    for (uint8_t seq = 0; seq < 5; seq++)
+        Frame(seq, Motor_ID, 0);
+    sentCount = 0;
+
+    // A jump of a whole window: the host restarted, no reports, old seqs forgotten
+    Frame(200, Motor_ID, 0);
+    CHECK(sentCount == 1);
+    Frame(3, Motor_ID, 0);
+    CHECK(AnswersFor(3, &status) == 1 && status == CONFIRM_ACK);
+}
+
+int main(void)
+{
+    Test_InOrder();
+    Test_RejectedThenNext();
+    Test_Gap();
+    Test_BurstLoss();
+    Test_Restart();
+    return TEST_RESULT();
+}
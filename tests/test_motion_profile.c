@@ -0,0 +1,160 @@
+#include "Test.h"
+#include "MotionProfile.h"
+#include <math.h>
+
+/*
+ * MotionProfile test at the steering rate (1 kHz, encoder counts): every
+ * step stays within the velocity and acceleration limits (and the jerk
+ * limit for S-curves), the setpoint reaches the target without
+ * overshooting and stops there, and a target or limit change mid-move
+ * continues without a velocity jump.
+ */
+
+#define DT        0.001f
+#define MAX_STEPS 20000U
+#define SLACK     1.01f // numerical margin on the limits
+
+static const MotionLimits trapezoid = {1200.0f, 6000.0f, 0.0f};
+static const MotionLimits sCurve = {1200.0f, 6000.0f, 200000.0f};
+
+typedef struct
+{
+    uint32_t steps;    // until done
+    float maxVelocity;
+    float maxAccel;
+    float maxJerk;
+    float overshoot;   // furthest past the target, in the direction of travel
+    float maxVelocityJump; // largest velocity change in one step
+} RunStats;
+
+static RunStats RunToTarget(MotionProfile *profile, float target)
+{
+    RunStats stats = {0};
+    float direction = (target >= profile->position) ? 1.0f : -1.0f;
+    float lastAccel = profile->accel;
+    float lastVelocity = profile->velocity;
+
+    MotionProfile_SetTarget(profile, target);
+    while (!profile->done && stats.steps < MAX_STEPS)
+    {
+        MotionProfile_Step(profile, DT);
+        stats.steps++;
+
+        float jerk = fabsf(profile->accel - lastAccel) / DT;
+        float jump = fabsf(profile->velocity - lastVelocity);
+        lastAccel = profile->accel;
+        lastVelocity = profile->velocity;
+
+        stats.maxVelocity = fmaxf(stats.maxVelocity, fabsf(profile->velocity));
+        stats.maxAccel = fmaxf(stats.maxAccel, fabsf(profile->accel));
+        if (!profile->done) // the snap onto the target drops accel at once
+            stats.maxJerk = fmaxf(stats.maxJerk, jerk);
+        stats.maxVelocityJump = fmaxf(stats.maxVelocityJump, jump);
+        stats.overshoot = fmaxf(stats.overshoot, (profile->position - target) * direction);
+    }
+    return stats;
+}
+
+static void CheckLimits(const RunStats *stats, const MotionLimits *limits)
+{
+    CHECK(stats->maxVelocity <= limits->maxVelocity * SLACK);
+    CHECK(stats->maxAccel <= limits->maxAccel * SLACK);
+    if (limits->maxJerk > 0.0f)
+        CHECK(stats->maxJerk <= limits->maxJerk * SLACK);
+}
+
+static void Test_Moves(const MotionLimits *limits, const char *name)
+{
+    static const float targets[] = {2000.0f, -500.0f, -510.0f, 3000.0f, 0.0f};
+    MotionProfile profile;
+    MotionProfile_Init(&profile, limits, 0.0f);
+
+    for (uint32_t i = 0; i < sizeof(targets) / sizeof(targets[0]); i++)
+    {
+        RunStats stats = RunToTarget(&profile, targets[i]);
+        CHECK(profile.done);
+        CHECK(profile.position == targets[i] && profile.velocity == 0.0f);
+        CHECK(stats.overshoot <= 1.0f);
+        CheckLimits(&stats, limits);
+        printf("%-9s  move to %6.0f: %5u ms, peak %6.1f counts/s\n",
+               name, targets[i], stats.steps, stats.maxVelocity);
+    }
+
+    // Long move of a trapezoid: cruise phase, time close to the ideal
+    if (limits->maxJerk == 0.0f)
+    {
+        MotionProfile_Reset(&profile, 0.0f);
+        RunStats stats = RunToTarget(&profile, 6000.0f);
+        float ideal = 6000.0f / limits->maxVelocity + limits->maxVelocity / limits->maxAccel;
+        CHECK(fabsf(stats.maxVelocity - limits->maxVelocity) < 1.0f);
+        CHECK(fabsf(stats.steps * DT - ideal) < 0.05f);
+    }
+}
+
+// Moves too short to reach cruise speed: braking starts while still accelerating
+static void Test_ShortMoves(const MotionLimits *limits)
+{
+    float worst = 0.0f;
+    uint32_t unfinished = 0;
+
+    for (uint32_t distance = 1; distance <= 400U; distance++)
+    {
+        MotionProfile profile;
+        MotionProfile_Init(&profile, limits, 0.0f);
+        RunStats stats = RunToTarget(&profile, (float)distance);
+        worst = fmaxf(worst, stats.overshoot);
+        unfinished += !profile.done;
+        CheckLimits(&stats, limits);
+    }
+    CHECK(unfinished == 0);
+    CHECK(worst <= 1.0f);
+}
+
+static void Test_Retarget(void)
+{
+    MotionProfile profile;
+    MotionProfile_Init(&profile, &sCurve, 0.0f);
+    MotionProfile_SetTarget(&profile, 3000.0f);
+    for (uint32_t i = 0; i < 500U; i++)
+        MotionProfile_Step(&profile, DT);
+    CHECK(profile.velocity > 0.0f && !profile.done);
+
+    // Reverse mid-move: decelerates through zero within the limits
+    RunStats stats = RunToTarget(&profile, -1000.0f);
+    CHECK(profile.done && profile.position == -1000.0f);
+    CheckLimits(&stats, &sCurve);
+    CHECK(stats.maxVelocityJump <= sCurve.maxAccel * DT * SLACK);
+
+    // Slower limits mid-move are obeyed from the next step on
+    const MotionLimits slow = {300.0f, 1000.0f, 0.0f};
+    MotionProfile_SetTarget(&profile, 1000.0f);
+    for (uint32_t i = 0; i < 200U; i++)
+        MotionProfile_Step(&profile, DT);
+    MotionProfile_SetLimits(&profile, &slow);
+    uint32_t steps = 0;
+    float peakAfter = 0.0f;
+    while (!profile.done && steps++ < MAX_STEPS)
+    {
+        float before = profile.velocity;
+        MotionProfile_Step(&profile, DT);
+        CHECK(fabsf(profile.velocity - before) <= slow.maxAccel * DT * SLACK);
+        if (steps > 2000U)
+            peakAfter = fmaxf(peakAfter, fabsf(profile.velocity));
+    }
+    CHECK(profile.done && profile.position == 1000.0f);
+    CHECK(peakAfter <= slow.maxVelocity * SLACK);
+
+    // A step when done does nothing
+    float position = MotionProfile_Step(&profile, DT);
+    CHECK(position == 1000.0f && profile.done);
+}
+
+int main(void)
+{
+    Test_Moves(&trapezoid, "trapezoid");
+    Test_Moves(&sCurve, "s-curve");
+    Test_ShortMoves(&trapezoid);
+    Test_ShortMoves(&sCurve);
+    Test_Retarget();
+    return TEST_RESULT();
+}
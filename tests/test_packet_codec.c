@@ -0,0 +1,114 @@
+#include "Test.h"
+#include "PacketCodec.h"
+#include "CheckSum.h"
+#include <string.h>
+
+/*
+ * PacketCodec test: encode/decode round trip for every payload length,
+ * the frame length taken from a header, and the rejection of frames with
+ * bad markers, a bad length or a corrupted CRC span. A rejected frame
+ * still reports the seq and packetID from its header for the NACK.
+ */
+
+static void Test_RoundTrip(void)
+{
+    uint32_t rng = 0x5EEDU;
+    uint8_t payload[PACKET_MAX_PAYLOAD];
+    uint8_t frame[PACKET_MAX_FRAME_SIZE];
+
+    for (uint8_t len = 0; len <= PACKET_MAX_PAYLOAD; len++)
+    {
+        for (uint8_t i = 0; i < len; i++)
+            payload[i] = (uint8_t)Test_Random(&rng);
+        uint8_t seq = (uint8_t)Test_Random(&rng);
+        uint8_t packetID = (uint8_t)(1U + Test_RandomBelow(&rng, 10));
+
+        uint16_t frameLen = PacketCodec_Encode(frame, seq, packetID, payload, len);
+        CHECK(frameLen == PACKET_OVERHEAD + len);
+        CHECK(PacketCodec_FrameLength(frame) == frameLen);
+        CHECK(PacketCodec_GetU16(frame) == PACKET_START_MARKER);
+        CHECK(PacketCodec_GetU16(frame + frameLen - PACKET_END_SIZE) == PACKET_END_MARKER);
+
+        PacketView view;
+        CHECK(PacketCodec_Decode(frame, frameLen, &view) == 0);
+        CHECK(view.seq == seq && view.packetID == packetID && view.len == len);
+        CHECK(view.payload == frame + PACKET_OFFSET_PAYLOAD);
+        CHECK(memcmp(view.payload, payload, len) == 0);
+    }
+
+    // Too long for a frame
+    CHECK(PacketCodec_Encode(frame, 0, 1, payload, PACKET_MAX_PAYLOAD + 1) == 0);
+}
+
+static void Test_FrameLength(void)
+{
+    uint8_t header[PACKET_HEADER_SIZE] = {0x55, 0xAA, 0, 1, 0};
+
+    header[PACKET_OFFSET_LEN] = 0;
+    CHECK(PacketCodec_FrameLength(header) == PACKET_OVERHEAD);
+    header[PACKET_OFFSET_LEN] = PACKET_MAX_PAYLOAD;
+    CHECK(PacketCodec_FrameLength(header) == PACKET_MAX_FRAME_SIZE);
+    header[PACKET_OFFSET_LEN] = PACKET_MAX_PAYLOAD + 1;
+    CHECK(PacketCodec_FrameLength(header) == 0);
+}
+
+static void Test_Rejected(void)
+{
+    const uint8_t payload[] = {1, 2, 3, 4};
+    uint8_t frame[PACKET_MAX_FRAME_SIZE];
+    uint8_t bad[PACKET_MAX_FRAME_SIZE];
+    uint16_t frameLen = PacketCodec_Encode(frame, 0x42, 0x02, payload, sizeof(payload));
+    PacketView view;
+
+    // Markers
+    memcpy(bad, frame, frameLen);
+    bad[0] ^= 0xFF;
+    CHECK(PacketCodec_Decode(bad, frameLen, &view) == 1);
+    CHECK(view.seq == 0x42 && view.packetID == 0x02 && view.payload == NULL);
+    memcpy(bad, frame, frameLen);
+    bad[frameLen - 1] ^= 0xFF;
+    CHECK(PacketCodec_Decode(bad, frameLen, &view) == 1);
+
+    // Length field and received length disagree
+    CHECK(PacketCodec_Decode(frame, frameLen - 1, &view) == 1);
+    memcpy(bad, frame, frameLen);
+    bad[PACKET_OFFSET_LEN]++;
+    CHECK(PacketCodec_Decode(bad, frameLen, &view) == 1);
+
+    // Shorter than a header: fields fall back to the neutral values
+    CHECK(PacketCodec_Decode(frame, 3, &view) == 1);
+    CHECK(view.seq == 0x42 && view.packetID == PACKET_ID_NONE);
+    CHECK(PacketCodec_Decode(frame, 0, &view) == 1);
+    CHECK(view.seq == 0 && view.packetID == PACKET_ID_NONE && view.len == 0);
+
+    // Every byte of the CRC span (seq, packetID, payload) and the CRC itself
+    uint32_t crcFailures = 0;
+    for (uint16_t at = PACKET_OFFSET_SEQ; at < frameLen - PACKET_END_SIZE; at++)
+    {
+        if (at == PACKET_OFFSET_LEN)
+            continue; // checked above, fails on the length
+        memcpy(bad, frame, frameLen);
+        bad[at] ^= 0x01;
+        crcFailures += (PacketCodec_Decode(bad, frameLen, &view) == 2);
+    }
+    CHECK(crcFailures == frameLen - PACKET_END_SIZE - PACKET_OFFSET_SEQ - 1U);
+}
+
+// Pinned values: the host side computes the same CRC, a table change breaks the link
+static void Test_Checksum(void)
+{
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    CHECK(crc16_table_calc(check, 0) == 0);
+    CHECK(crc16_table_calc(check, sizeof(check)) == 0x005C);
+    CHECK(checksum((uint8_t *)check, sizeof(check)) == 0x005C);
+}
+
+int main(void)
+{
+    Test_RoundTrip();
+    Test_FrameLength();
+    Test_Rejected();
+    Test_Checksum();
+    return TEST_RESULT();
+}
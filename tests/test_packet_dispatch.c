@@ -0,0 +1,314 @@
+#include "Test.h"
+#include "Packet.h"
+#include "Log.h"
+#include "Motor_Angle.h"
+#include "Speed_Motor.h"
+#include "Horn.h"
+#include "Light.h"
+#include "PwmOut.h"
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HOST_CYCLES 1
+#endif
+
+/*
+ * SerializePacket test and benchmark.
+ *
+ * The actuators and the logger are replaced by stubs that record the last
+ * call, so every packet type is checked to reach its handler with the
+ * decoded fields, and bad commands to be rejected with their error code
+ * before anything moves. The benchmark then dispatches a mix of all
+ * single-command types (and, separately, batches and rejected commands)
+ * and prints the cost per command: ns, and host TSC cycles on x86.
+ * The stubs count calls only, so the figures are lookup, range checks,
+ * decoding and the handler call. Host cycles are not Cortex-M4 cycles;
+ * Packet_GetDispatchStats and the Bench module give the on-target figure.
+ */
+
+#define BENCH_SECONDS 0.2
+
+/* ==================== Stubs ==================== */
+
+typedef struct
+{
+    const char *name; // last stub called, NULL if none
+    int32_t args[3];
+    uint32_t calls;
+    uint32_t logs;
+} StubCalls;
+
+static StubCalls stub;
+
+static void Stub_Record(const char *name, int32_t a, int32_t b, int32_t c)
+{
+    stub.name = name;
+    stub.args[0] = a;
+    stub.args[1] = b;
+    stub.args[2] = c;
+    stub.calls++;
+}
+
+void Motor_SetSpeed(uint8_t motorID, uint8_t speed, uint8_t direction) { Stub_Record("SetSpeed", motorID, speed, direction); }
+void Motor_Drive(uint8_t motorID, uint8_t speed, uint8_t direction, uint16_t duration_ms)
+{
+    Stub_Record("Drive", motorID, speed, (int32_t)direction << 16 | duration_ms);
+}
+void Motor_SetRpm(uint8_t motorID, int16_t rpm) { Stub_Record("SetRpm", motorID, rpm, 0); }
+void Motor_GotoAngle(uint8_t angle_deg, uint8_t direction) { Stub_Record("GotoAngle", angle_deg, direction, 0); }
+void Motor_Angle_Recalibrate(void) { Stub_Record("Recalibrate", 0, 0, 0); }
+void Horn_Play(HornPattern pattern, uint32_t duration_ms) { Stub_Record("HornPlay", pattern, (int32_t)duration_ms, 0); }
+void Light_Front_On(void) { Stub_Record("Light", 1, 0, 0); }
+void Light_Front_Off(void) { Stub_Record("Light", 0, 0, 0); }
+void Light_Back_On(void) { Stub_Record("Light", 2, 0, 0); }
+void Light_Back_Off(void) { Stub_Record("Light", 3, 0, 0); }
+void Light_Right_On(void) { Stub_Record("Light", 4, 0, 0); }
+void Light_Right_Off(void) { Stub_Record("Light", 5, 0, 0); }
+void Light_Left_On(void) { Stub_Record("Light", 6, 0, 0); }
+void Light_Left_Off(void) { Stub_Record("Light", 7, 0, 0); }
+uint8_t PwmOut_SetInaudible(uint8_t enable)
+{
+    Stub_Record("PwmMode", enable, 0, 0);
+    return 1;
+}
+void Log_Write(LogSiteId id, const int32_t *args)
+{
+    (void)id;
+    (void)args;
+    stub.logs++;
+}
+
+/* ==================== Helpers ==================== */
+
+static PacketView View(uint8_t packetID, const uint8_t *payload, uint8_t len)
+{
+    PacketView view = {.seq = 0, .packetID = packetID, .len = len, .payload = payload};
+    return view;
+}
+
+// Dispatch one command with the stubs cleared, returns the result code
+static uint8_t Dispatch(uint8_t packetID, const uint8_t *payload, uint8_t len)
+{
+    PacketView view = View(packetID, payload, len);
+    memset(&stub, 0, sizeof(stub));
+    return SerializePacket(&view);
+}
+
+static uint8_t Called(const char *name, int32_t a, int32_t b, int32_t c)
+{
+    return stub.calls == 1 && stub.name && strcmp(stub.name, name) == 0 &&
+           stub.args[0] == a && stub.args[1] == b && stub.args[2] == c;
+}
+
+/* ==================== Tests ==================== */
+
+static void Test_Handlers(void)
+{
+    CHECK(Dispatch(Motor_ID, (const uint8_t[]){2, 55, 1}, 3) == 0);
+    CHECK(Called("SetSpeed", 2, 55, 1));
+
+    CHECK(Dispatch(MotorTimed_ID, (const uint8_t[]){3, 40, 0, 0xE8, 0x03}, 5) == 0);
+    CHECK(Called("Drive", 3, 40, 1000));
+
+    CHECK(Dispatch(MotorRpm_ID, (const uint8_t[]){1, 0x38, 0xFF}, 3) == 0); // -200
+    CHECK(Called("SetRpm", 1, -200, 0));
+
+    CHECK(Dispatch(MotorAngle_ID, (const uint8_t[]){1, 45, 0, 1}, 4) == 0);
+    CHECK(Called("GotoAngle", 45, 1, 0));
+
+    CHECK(Dispatch(MotorCalibrate_ID, (const uint8_t[]){1}, 1) == 0);
+    CHECK(Called("Recalibrate", 0, 0, 0));
+
+    CHECK(Dispatch(CarHorn_ID, (const uint8_t[]){1, 3, HORN_PATTERN_SOS}, 3) == 0);
+    CHECK(Called("HornPlay", HORN_PATTERN_SOS, 3000, 0));
+
+    for (uint8_t status = 0; status < 8; status++)
+    {
+        CHECK(Dispatch(CarLight_ID, (const uint8_t[]){1, status}, 2) == 0);
+        CHECK(Called("Light", status, 0, 0));
+    }
+
+    CHECK(Dispatch(PwmMode_ID, (const uint8_t[]){1, 0}, 2) == 0);
+    CHECK(Called("PwmMode", 0, 0, 0));
+    CHECK(Dispatch(PwmMode_ID, (const uint8_t[]){1, 1}, 2) == 0);
+    CHECK(Called("PwmMode", 1, 0, 0));
+
+    CHECK(Dispatch(CarConfirmation_ID, (const uint8_t[]){1, 2, 3, 4}, 4) == 0);
+    CHECK(stub.calls == 0);
+    CHECK(Dispatch(Heartbeat_ID, NULL, 0) == 0);
+    CHECK(stub.calls == 0);
+}
+
+static void Test_Rejected(void)
+{
+    // Each rejection returns its code and actuates nothing
+    CHECK(Dispatch(0x7F, (const uint8_t[]){1}, 1) == 3);
+    CHECK(stub.calls == 0 && stub.logs == 1);
+    CHECK(Dispatch(PACKET_ID_NONE, NULL, 0) == 3);
+    CHECK(stub.calls == 0);
+    CHECK(Dispatch(Motor_ID, (const uint8_t[]){1, 50}, 2) == 9);
+    CHECK(stub.calls == 0);
+    CHECK(Dispatch(Motor_ID, (const uint8_t[]){4, 50, 1}, 3) == 5);
+    CHECK(Dispatch(Motor_ID, (const uint8_t[]){1, 101, 1}, 3) == 6);
+    CHECK(Dispatch(Motor_ID, (const uint8_t[]){1, 50, 2}, 3) == 7);
+    CHECK(Dispatch(MotorAngle_ID, (const uint8_t[]){1, 91, 0, 1}, 4) == 4);
+    CHECK(Dispatch(MotorAngle_ID, (const uint8_t[]){1, 0xFF, 0xFF, 1}, 4) == 4); // -1
+    CHECK(Dispatch(MotorRpm_ID, (const uint8_t[]){1, 0x2D, 0x01}, 3) == 6);     // 301
+    CHECK(Dispatch(CarLight_ID, (const uint8_t[]){1, 8}, 2) == 8);
+    CHECK(Dispatch(CarHorn_ID, (const uint8_t[]){1, 1, HORN_PATTERN_COUNT}, 3) == 11);
+    CHECK(Dispatch(MotorCalibrate_ID, (const uint8_t[]){2}, 1) == 5);
+    CHECK(Dispatch(PwmMode_ID, (const uint8_t[]){1, 2}, 2) == 12);
+    CHECK(stub.calls == 0);
+    CHECK(SerializePacket(NULL) == 4);
+}
+
+static void Test_Batch(void)
+{
+    static const uint8_t good[] = {
+        3,
+        Motor_ID, 1, 20, 1,
+        CarLight_ID, 1, 4,
+        MotorAngle_ID, 1, 30, 0, 0,
+    };
+    CHECK(Dispatch(CarBatch_ID, good, sizeof(good)) == 0);
+    CHECK(stub.calls == 3);
+    CHECK(strcmp(stub.name, "GotoAngle") == 0 && stub.args[0] == 30);
+
+    // A bad last record rejects the whole batch before anything moves
+    static const uint8_t badField[] = {
+        2,
+        Motor_ID, 1, 20, 1,
+        CarLight_ID, 1, 9,
+    };
+    CHECK(Dispatch(CarBatch_ID, badField, sizeof(badField)) == 8);
+    CHECK(stub.calls == 0);
+
+    static const uint8_t nested[] = {1, CarBatch_ID, 0};
+    CHECK(Dispatch(CarBatch_ID, nested, sizeof(nested)) == 3);
+    static const uint8_t shortRecord[] = {2, Motor_ID, 1, 20, 1, CarLight_ID, 1};
+    CHECK(Dispatch(CarBatch_ID, shortRecord, sizeof(shortRecord)) == 9);
+    static const uint8_t trailing[] = {1, CarLight_ID, 1, 4, 0};
+    CHECK(Dispatch(CarBatch_ID, trailing, sizeof(trailing)) == 9);
+    static const uint8_t tooMany[] = {BATCH_MAX_COMMANDS + 1};
+    CHECK(Dispatch(CarBatch_ID, tooMany, sizeof(tooMany)) == 10);
+    CHECK(stub.calls == 0);
+}
+
+/* ==================== Benchmark ==================== */
+
+static const uint8_t motorPayload[] = {1, 60, 1};
+static const uint8_t timedPayload[] = {3, 40, 0, 0xF4, 0x01};
+static const uint8_t rpmPayload[] = {2, 0x96, 0x00};
+static const uint8_t anglePayload[] = {1, 20, 0, 0};
+static const uint8_t hornPayload[] = {1, 2, HORN_PATTERN_DOUBLE};
+static const uint8_t lightPayload[] = {1, 5};
+static const uint8_t confirmPayload[] = {1, 1, 0, 0};
+static const uint8_t batchPayload[] = {
+    BATCH_MAX_COMMANDS,
+    Motor_ID, 1, 20, 1,
+    Motor_ID, 2, 20, 1,
+    CarLight_ID, 1, 1,
+    CarLight_ID, 1, 2,
+    MotorAngle_ID, 1, 30, 0, 0,
+    Heartbeat_ID,
+};
+static const uint8_t badRangePayload[] = {1, 50, 2};
+
+typedef struct
+{
+    const char *name;
+    PacketView views[10];
+    uint8_t count;
+    uint8_t commandsPerView; // commands carried by one view (batch)
+    uint8_t expect;          // SerializePacket result
+} BenchMix;
+
+typedef struct
+{
+    double nsPerCommand;
+    double cyclesPerCommand; // host TSC, 0 if unavailable
+} BenchResult;
+
+static BenchResult Bench(const BenchMix *mix)
+{
+    BenchResult result = {0};
+    uint64_t commands = 0;
+    uint32_t failed = 0;
+    double start = Test_Seconds();
+    double elapsed;
+#ifdef HOST_CYCLES
+    uint64_t tscStart = __rdtsc();
+#endif
+
+    do
+    {
+        for (uint32_t rep = 0; rep < 1000; rep++)
+            for (uint8_t i = 0; i < mix->count; i++)
+                failed += (SerializePacket(&mix->views[i]) != mix->expect);
+        commands += 1000ULL * mix->count * mix->commandsPerView;
+        elapsed = Test_Seconds() - start;
+    } while (elapsed < BENCH_SECONDS);
+
+#ifdef HOST_CYCLES
+    result.cyclesPerCommand = (double)(__rdtsc() - tscStart) / (double)commands;
+#endif
+    result.nsPerCommand = elapsed * 1e9 / (double)commands;
+    CHECK(failed == 0);
+
+    printf("dispatch:  %-8s %6.1f ns/command", mix->name, result.nsPerCommand);
+    if (result.cyclesPerCommand > 0)
+        printf(", %6.1f host cycles/command", result.cyclesPerCommand);
+    printf(" (%llu commands)\n", (unsigned long long)commands);
+    return result;
+}
+
+static void Test_Benchmark(void)
+{
+    BenchMix single = {
+        .name = "single",
+        .views = {
+            View(Motor_ID, motorPayload, sizeof(motorPayload)),
+            View(MotorTimed_ID, timedPayload, sizeof(timedPayload)),
+            View(MotorRpm_ID, rpmPayload, sizeof(rpmPayload)),
+            View(MotorAngle_ID, anglePayload, sizeof(anglePayload)),
+            View(CarHorn_ID, hornPayload, sizeof(hornPayload)),
+            View(CarLight_ID, lightPayload, sizeof(lightPayload)),
+            View(CarConfirmation_ID, confirmPayload, sizeof(confirmPayload)),
+            View(Heartbeat_ID, NULL, 0),
+        },
+        .count = 8,
+        .commandsPerView = 1,
+        .expect = 0,
+    };
+    BenchMix batch = {
+        .name = "batch",
+        .views = {View(CarBatch_ID, batchPayload, sizeof(batchPayload))},
+        .count = 1,
+        .commandsPerView = BATCH_MAX_COMMANDS,
+        .expect = 0,
+    };
+    BenchMix rejected = {
+        .name = "rejected",
+        .views = {View(Motor_ID, badRangePayload, sizeof(badRangePayload))},
+        .count = 1,
+        .commandsPerView = 1,
+        .expect = 7,
+    };
+
+    Bench(&single);
+    Bench(&batch);
+    Bench(&rejected);
+
+    PacketDispatchStats stats;
+    Packet_GetDispatchStats(&stats);
+    CHECK(stats.dispatched > 0);
+}
+
+int main(void)
+{
+    Test_Handlers();
+    Test_Rejected();
+    Test_Batch();
+    Test_Benchmark();
+    return TEST_RESULT();
+}
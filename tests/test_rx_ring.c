@@ -0,0 +1,173 @@
+#include "Test.h"
+#include "RxRing.h"
+#include <string.h>
+
+/*
+ * RxRing test: simulated DMA head positions against a reference model.
+ *
+ * A fake DMA writes an increasing byte counter into a circular buffer and
+ * raises the events the UART does: IDLE at the current position, TC with
+ * head == size when it reaches the end of the buffer. The bytes handed on
+ * through the spans must be exactly the bytes written, in order.
+ */
+
+#define RING_SIZE 64U
+#define FUZZ_EVENTS 200000U
+
+static uint8_t ring[RING_SIZE];
+static uint16_t dmaPos;     // next index the fake DMA writes
+static uint8_t writeValue;  // next byte the fake DMA writes
+static uint8_t readValue;   // next byte the reader expects
+static uint16_t tail;
+static uint32_t received;
+
+static void Reset(void)
+{
+    memset(ring, 0, sizeof(ring));
+    dmaPos = 0;
+    writeValue = 0;
+    readValue = 0;
+    tail = 0;
+    received = 0;
+}
+
+// Reader side, as UartRx_OnEvent: returns 1 if every byte came in order
+static uint8_t Event(uint16_t head)
+{
+    RxSpan spans[2];
+    uint8_t count = RxRing_Advance(&tail, head, RING_SIZE, spans);
+    uint8_t ok = 1;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (spans[i].len == 0 || spans[i].start + spans[i].len > RING_SIZE)
+            ok = 0;
+        for (uint16_t b = 0; b < spans[i].len; b++)
+        {
+            ok &= (ring[spans[i].start + b] == readValue);
+            readValue++;
+            received++;
+        }
+    }
+    return ok;
+}
+
+// DMA side: write n bytes, with a TC event at the end of the buffer
+static uint8_t Write(uint16_t n)
+{
+    uint8_t ok = 1;
+    while (n--)
+    {
+        ring[dmaPos++] = writeValue++;
+        if (dmaPos == RING_SIZE)
+        {
+            ok &= Event(RING_SIZE);
+            dmaPos = 0;
+        }
+    }
+    return ok;
+}
+
+static void Test_Spans(void)
+{
+    RxSpan spans[2];
+    uint16_t t;
+
+    // Plain run, no wrap
+    t = 10;
+    CHECK(RxRing_Advance(&t, 25, RING_SIZE, spans) == 1);
+    CHECK(spans[0].start == 10 && spans[0].len == 15 && t == 25);
+
+    // Head equal to the last position: nothing new, tail stays
+    t = 25;
+    CHECK(RxRing_Advance(&t, 25, RING_SIZE, spans) == 0);
+    CHECK(t == 25);
+    t = 0;
+    CHECK(RxRing_Advance(&t, 0, RING_SIZE, spans) == 0);
+    CHECK(t == 0);
+
+    // Wrap-around: end of the buffer, then the start
+    t = 50;
+    CHECK(RxRing_Advance(&t, 6, RING_SIZE, spans) == 2);
+    CHECK(spans[0].start == 50 && spans[0].len == 14);
+    CHECK(spans[1].start == 0 && spans[1].len == 6);
+    CHECK(t == 6);
+
+    // Wrapped exactly to the start: only the end of the buffer
+    t = 50;
+    CHECK(RxRing_Advance(&t, 0, RING_SIZE, spans) == 1);
+    CHECK(spans[0].start == 50 && spans[0].len == 14 && t == 0);
+
+    // TC at the end of the buffer: tail wraps to 0
+    t = 40;
+    CHECK(RxRing_Advance(&t, RING_SIZE, RING_SIZE, spans) == 1);
+    CHECK(spans[0].start == 40 && spans[0].len == 24 && t == 0);
+
+    // Full-buffer lap: tail 0, TC reports the whole buffer
+    t = 0;
+    CHECK(RxRing_Advance(&t, RING_SIZE, RING_SIZE, spans) == 1);
+    CHECK(spans[0].start == 0 && spans[0].len == RING_SIZE && t == 0);
+
+    // Head past the buffer: ignored, tail untouched
+    t = 12;
+    CHECK(RxRing_Advance(&t, RING_SIZE + 1, RING_SIZE, spans) == 0);
+    CHECK(t == 12);
+}
+
+static void Test_Sequences(void)
+{
+    // Full lap between two IDLE events at the same position
+    Reset();
+    CHECK(Write(20));
+    CHECK(Event(dmaPos));
+    CHECK(Write(RING_SIZE));
+    CHECK(Event(dmaPos));
+    CHECK(received == 20 + RING_SIZE && readValue == writeValue);
+
+    // Full lap from 0: TC reports it, the IDLE that follows is empty
+    Reset();
+    CHECK(Write(RING_SIZE));
+    CHECK(tail == 0 && received == RING_SIZE);
+    CHECK(Event(dmaPos));
+    CHECK(received == RING_SIZE);
+
+    // Burst that ends exactly on the last byte, then a wrap-around burst
+    Reset();
+    CHECK(Write(RING_SIZE - 1));
+    CHECK(Event(dmaPos));
+    CHECK(Write(1));
+    CHECK(Event(dmaPos));
+    CHECK(Write(30));
+    CHECK(Event(dmaPos));
+    CHECK(received == RING_SIZE + 30 && readValue == writeValue);
+}
+
+static void Test_Fuzz(void)
+{
+    uint32_t rng = 0xD11A5EEDU;
+    uint32_t written = 0;
+    uint8_t ok = 1;
+
+    Reset();
+    for (uint32_t i = 0; i < FUZZ_EVENTS; i++)
+    {
+        // Bursts from nothing to over a full lap between IDLE events
+        uint16_t n = (uint16_t)Test_RandomBelow(&rng, 2U * RING_SIZE);
+        ok &= Write(n);
+        written += n;
+        ok &= Event(dmaPos);
+    }
+
+    CHECK(ok);
+    CHECK(received == written);
+    CHECK(readValue == writeValue);
+    printf("rx ring:   %u events, %u bytes in order\n", FUZZ_EVENTS, received);
+}
+
+int main(void)
+{
+    Test_Spans();
+    Test_Sequences();
+    Test_Fuzz();
+    return TEST_RESULT();
+}
@@ -0,0 +1,132 @@
+#include "Test.h"
+#include "SoftTimer.h"
+
+/*
+ * SoftTimer test: a timer started for n ms fires on the n-th tick, once;
+ * restarting supersedes the pending expiry, stopping cancels it, and a
+ * callback may restart its own slot (how the horn steps its pattern).
+ */
+
+static uint32_t fired[SOFT_TIMER_COUNT];
+static uint32_t firedAtTick[SOFT_TIMER_COUNT];
+static uint32_t tick;
+static uint32_t rearmLeft;
+
+static void OnExpire(void *arg)
+{
+    SoftTimerId id = (SoftTimerId)(uintptr_t)arg;
+    fired[id]++;
+    firedAtTick[id] = tick;
+}
+
+static void OnExpireRearm(void *arg)
+{
+    OnExpire(arg);
+    if (rearmLeft > 0)
+    {
+        rearmLeft--;
+        SoftTimer_Start((SoftTimerId)(uintptr_t)arg, 3, OnExpireRearm, arg);
+    }
+}
+
+static void Reset(void)
+{
+    SoftTimer_Init();
+    for (uint8_t i = 0; i < SOFT_TIMER_COUNT; i++)
+    {
+        fired[i] = 0;
+        firedAtTick[i] = 0;
+    }
+    tick = 0;
+}
+
+static void Run(uint32_t ticks)
+{
+    while (ticks--)
+    {
+        tick++;
+        SoftTimer_Tick();
+    }
+}
+
+static void *Arg(SoftTimerId id)
+{
+    return (void *)(uintptr_t)id;
+}
+
+static void Test_OneShot(void)
+{
+    Reset();
+    SoftTimer_Start(SOFT_TIMER_MOTOR1, 5, OnExpire, Arg(SOFT_TIMER_MOTOR1));
+    SoftTimer_Start(SOFT_TIMER_HORN, 1, OnExpire, Arg(SOFT_TIMER_HORN));
+    CHECK(SoftTimer_IsRunning(SOFT_TIMER_MOTOR1));
+    CHECK(!SoftTimer_IsRunning(SOFT_TIMER_MOTOR2));
+
+    Run(4);
+    CHECK(fired[SOFT_TIMER_MOTOR1] == 0);
+    CHECK(fired[SOFT_TIMER_HORN] == 1 && firedAtTick[SOFT_TIMER_HORN] == 1);
+    CHECK(!SoftTimer_IsRunning(SOFT_TIMER_HORN));
+
+    Run(1);
+    CHECK(fired[SOFT_TIMER_MOTOR1] == 1 && firedAtTick[SOFT_TIMER_MOTOR1] == 5);
+    CHECK(!SoftTimer_IsRunning(SOFT_TIMER_MOTOR1));
+
+    Run(100);
+    CHECK(fired[SOFT_TIMER_MOTOR1] == 1 && fired[SOFT_TIMER_HORN] == 1);
+}
+
+static void Test_RestartAndStop(void)
+{
+    Reset();
+    SoftTimer_Start(SOFT_TIMER_MOTOR1, 10, OnExpire, Arg(SOFT_TIMER_MOTOR1));
+    Run(8);
+    SoftTimer_Start(SOFT_TIMER_MOTOR1, 10, OnExpire, Arg(SOFT_TIMER_MOTOR1));
+    Run(9);
+    CHECK(fired[SOFT_TIMER_MOTOR1] == 0);
+    Run(1);
+    CHECK(fired[SOFT_TIMER_MOTOR1] == 1 && firedAtTick[SOFT_TIMER_MOTOR1] == 18);
+
+    SoftTimer_Start(SOFT_TIMER_MOTOR2, 4, OnExpire, Arg(SOFT_TIMER_MOTOR2));
+    Run(2);
+    SoftTimer_Stop(SOFT_TIMER_MOTOR2);
+    CHECK(!SoftTimer_IsRunning(SOFT_TIMER_MOTOR2));
+    Run(10);
+    CHECK(fired[SOFT_TIMER_MOTOR2] == 0);
+
+    // 0 ms stops instead of firing
+    SoftTimer_Start(SOFT_TIMER_MOTOR2, 4, OnExpire, Arg(SOFT_TIMER_MOTOR2));
+    SoftTimer_Start(SOFT_TIMER_MOTOR2, 0, OnExpire, Arg(SOFT_TIMER_MOTOR2));
+    CHECK(!SoftTimer_IsRunning(SOFT_TIMER_MOTOR2));
+    Run(10);
+    CHECK(fired[SOFT_TIMER_MOTOR2] == 0);
+
+    // No callback: just runs out
+    SoftTimer_Start(SOFT_TIMER_HORN, 2, NULL, NULL);
+    Run(2);
+    CHECK(!SoftTimer_IsRunning(SOFT_TIMER_HORN));
+
+    // Init stops everything
+    SoftTimer_Start(SOFT_TIMER_HORN, 2, OnExpire, Arg(SOFT_TIMER_HORN));
+    SoftTimer_Init();
+    Run(5);
+    CHECK(fired[SOFT_TIMER_HORN] == 0);
+}
+
+static void Test_RearmFromCallback(void)
+{
+    Reset();
+    rearmLeft = 3;
+    SoftTimer_Start(SOFT_TIMER_HORN, 3, OnExpireRearm, Arg(SOFT_TIMER_HORN));
+    Run(100);
+    CHECK(fired[SOFT_TIMER_HORN] == 4);
+    CHECK(firedAtTick[SOFT_TIMER_HORN] == 12);
+    CHECK(!SoftTimer_IsRunning(SOFT_TIMER_HORN));
+}
+
+int main(void)
+{
+    Test_OneShot();
+    Test_RestartAndStop();
+    Test_RearmFromCallback();
+    return TEST_RESULT();
+}
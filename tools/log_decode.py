@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""Decode the binary debug log sent on USART1 (see Core/Inc/Log.h).
+
+Site names, argument counts and formats are read from Core/Inc/LogSites.h,
+so the decoder always matches the firmware it is built from.
+
+Usage:
+    log_decode.py capture.bin                 # raw bytes saved from the UART
+    log_decode.py /dev/ttyUSB0 --baud 115200  # live, needs pyserial
+    cat capture.bin | log_decode.py -
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+LOG_SYNC = 0xA5
+HEADER = struct.Struct("<BBI")  # sync, site ID, HAL tick
+
+SITES_H = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                       "..", "Core", "Inc", "LogSites.h")
+SITE_RE = re.compile(r'^\s*LOG_SITE\(\s*(\w+)\s*,\s*(\d+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', re.M)
+
+
+def load_sites(path):
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    return [(name, int(nargs), fmt.encode().decode("unicode_escape"))
+            for name, nargs, fmt in SITE_RE.findall(text)]
+
+
+def open_input(source, baud):
+    if source == "-":
+        return sys.stdin.buffer
+    if source.startswith("/dev/") or source.upper().startswith("COM"):
+        import serial  # pyserial, only needed for live capture
+        return serial.Serial(source, baud, timeout=1)
+    return open(source, "rb")
+
+
+def records(stream, sites):
+    """Yield (tick, name, text), skipping bytes until a valid record starts."""
+    buf = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if hasattr(stream, "is_open"):
+                continue  # serial timeout, keep waiting
+            return
+        buf += chunk
+        while len(buf) >= HEADER.size:
+            if buf[0] != LOG_SYNC or buf[1] >= len(sites):
+                del buf[0]  # resync
+                continue
+            name, nargs, fmt = sites[buf[1]]
+            size = HEADER.size + 4 * nargs
+            if len(buf) < size:
+                break
+            _, _, tick = HEADER.unpack_from(buf)
+            args = struct.unpack_from("<%di" % nargs, buf, HEADER.size)
+            del buf[:size]
+            try:
+                text = fmt % args
+            except (TypeError, ValueError):
+                text = "%s %r" % (fmt, args)
+            yield tick, name, text
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("source", help="capture file, serial port or - for stdin")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--sites", default=SITES_H, help="path to LogSites.h")
+    args = parser.parse_args()
+
+    sites = load_sites(args.sites)
+    try:
+        for tick, name, text in records(open_input(args.source, args.baud), sites):
+            print("%10u ms  %-20s %s" % (tick, name, text), flush=True)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()